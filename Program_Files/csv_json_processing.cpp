@@ -2,13 +2,78 @@
 #include <iostream>
 #include <cstdlib>
 #include "third_party/fast-cpp-csv-parser/csv.h"
+#include "fast_csv_reader.h"
+#include "parallel_csv_parser.h"
+#include "transaction_fields.h"
 #include "third_party/rapidjson/include/rapidjson/prettywriter.h" 
 #include "third_party/rapidjson/include/rapidjson/filewritestream.h"
 
-ThreadSafeQueue<Transaction> txQueue;
+ThreadSafeQueue<QueuedTransaction> txQueue;
 
-void parserWorker(const std::string& inFile) {
-    io::CSVReader<18, io::trim_chars<' '>, io::no_quote_escape<','>> in(inFile);
+// Typed columns are written back as the text they were parsed from, so the
+// JSON layout is the same as when every column was a string. Columns outside
+// `columns` (not loaded by a projected load) are left out of the object.
+template<typename Writer>
+static void writeTransactionObject(Writer& writer, const Transaction& tx, const TransactionTextView& text,
+                                   CsvColumnSet columns = ALL_CSV_COLUMNS) {
+    char buffer[FIELD_TEXT_CAPACITY];
+    auto writeText = [&](std::string_view value) {
+        writer.String(value.data(), static_cast<rapidjson::SizeType>(value.size()));
+    };
+    auto key = [&](CsvColumn column) {
+        if ((columns & csvColumnBit(column)) == 0) return false;
+        writer.Key(CSV_COLUMN_NAMES[column]);
+        return true;
+    };
+    writer.StartObject();
+    if (key(CSV_TRANSACTION_ID))           writeText(text.transaction_id);
+    if (key(CSV_TIMESTAMP))                writer.String(buffer, formatTimestampMicros(tx.timestamp, buffer));
+    if (key(CSV_SENDER_ACCOUNT))           writeText(text.sender_account);
+    if (key(CSV_RECEIVER_ACCOUNT))         writeText(text.receiver_account);
+    if (key(CSV_AMOUNT))                   writer.Double(tx.amount);
+    if (key(CSV_TRANSACTION_TYPE))         writer.String(categoryName(CATEGORY_TRANSACTION_TYPE, tx.transaction_type).c_str());
+    if (key(CSV_MERCHANT_CATEGORY))        writer.String(categoryName(CATEGORY_MERCHANT_CATEGORY, tx.merchant_category).c_str());
+    if (key(CSV_LOCATION))                 writer.String(categoryName(CATEGORY_LOCATION, tx.location).c_str());
+    if (key(CSV_DEVICE_USED))              writer.String(categoryName(CATEGORY_DEVICE_USED, tx.device_used).c_str());
+    if (key(CSV_IS_FRAUD))                 writer.Bool(tx.is_fraud);
+    if (key(CSV_FRAUD_TYPE))               writer.String(categoryName(CATEGORY_FRAUD_TYPE, tx.fraud_type).c_str());
+    if (key(CSV_TIME_SINCE_LAST_TRANSACTION)) writer.String(buffer, formatNullableDouble(tx.time_since_last_transaction, buffer));
+    if (key(CSV_SPENDING_DEVIATION_SCORE)) writer.Double(tx.spending_deviation_score);
+    if (key(CSV_VELOCITY_SCORE))           writer.Double(tx.velocity_score);
+    if (key(CSV_GEO_ANOMALY_SCORE))        writer.Double(tx.geo_anomaly_score);
+    if (key(CSV_PAYMENT_CHANNEL))          writer.String(categoryName(CATEGORY_PAYMENT_CHANNEL, tx.payment_channel).c_str());
+    if (key(CSV_IP_ADDRESS))               writer.String(buffer, formatIPv4(tx.ip_address, buffer));
+    if (key(CSV_DEVICE_HASH))              writeText(text.device_hash);
+    writer.EndObject();
+}
+
+static void mappedParseFile(const std::string& inFile, int threadCount, CsvRejectLog* rejects) {
+    MappedCsvFile file;
+    const char* cursor = nullptr;
+    CsvColumnLayout layout;
+    if (file.open(inFile)) {
+        cursor = file.begin();
+        if (layout.parseHeader(cursor, file.end())) {
+            CsvParseOptions options;
+            options.rejects = rejects;
+            options.sourceName = inFile;
+            try {
+                parseCsvChunksInOrder(cursor, file.end(), layout, threadCount, [](TransactionArray& rows) {
+                    for (int i = 0; i < rows.getSize(); ++i) {
+                        Transaction& tx = *rows.getTransaction(i);
+                        txQueue.push(QueuedTransaction{std::move(tx), rows.getText(tx).toText()});
+                    }
+                    return true;
+                }, options);
+            } catch (const std::exception& e) {
+                std::cerr << "Error parsing " << inFile << ": " << e.what() << std::endl;
+            }
+        }
+    }
+}
+
+static void legacyParseFile(const std::string& inFile, CsvRejectLog* rejects) {
+    io::CSVReader<18, io::trim_chars<' '>, io::double_quote_escape<',', '"'>> in(inFile);
     in.read_header(io::ignore_no_column,
         "transaction_id","timestamp","sender_account","receiver_account",
         "amount","transaction_type","merchant_category","location",
@@ -18,32 +83,63 @@ void parserWorker(const std::string& inFile) {
     );
     std::string id, ts, sa, ra, amt_s, tt, mc, loc, du,
                 fraud_s, ft, tsl, sds_s, vs_s, gas_s, pc, ip, dh;
-    while (in.read_row(
-        id, ts, sa, ra, amt_s, tt, mc, loc, du,
-        fraud_s, ft, tsl, sds_s, vs_s, gas_s, pc, ip, dh
-    )) {
+    while (true) {
         Transaction tx;
-        tx.transaction_id               = std::move(id);
-        tx.timestamp                    = std::move(ts);
-        tx.sender_account               = std::move(sa);
-        tx.receiver_account             = std::move(ra);
-        tx.amount                       = std::strtod(amt_s.c_str(), nullptr);
-        tx.transaction_type             = std::move(tt);
-        tx.merchant_category            = std::move(mc);
-        tx.location                     = std::move(loc);
-        tx.device_used                  = std::move(du);
-        tx.is_fraud                     = (fraud_s == "True" || fraud_s == "true");
-        tx.fraud_type                   = std::move(ft);
-        tx.time_since_last_transaction  = std::move(tsl);
-        tx.spending_deviation_score     = std::strtod(sds_s.c_str(), nullptr);
-        tx.velocity_score               = std::strtod(vs_s.c_str(), nullptr);
-        tx.geo_anomaly_score            = std::strtod(gas_s.c_str(), nullptr);
-        tx.payment_channel              = std::move(pc);
-        tx.ip_address                   = std::move(ip);
-        tx.device_hash                  = std::move(dh);
-
-        txQueue.push(std::move(tx));
+        TransactionText text;
+        try {
+            if (!in.read_row(
+                id, ts, sa, ra, amt_s, tt, mc, loc, du,
+                fraud_s, ft, tsl, sds_s, vs_s, gas_s, pc, ip, dh
+            )) {
+                break;
+            }
+            text.transaction_id             = std::move(id);
+            tx.timestamp                    = parseTimestampMicros(ts.data(), ts.size());
+            text.sender_account             = std::move(sa);
+            text.receiver_account           = std::move(ra);
+            tx.amount                       = parseRequiredDouble(amt_s.data(), amt_s.size());
+            tx.transaction_type             = encodeCategory(CATEGORY_TRANSACTION_TYPE, tt.data(), tt.size());
+            tx.merchant_category            = encodeCategory(CATEGORY_MERCHANT_CATEGORY, mc.data(), mc.size());
+            tx.location                     = encodeCategory(CATEGORY_LOCATION, loc.data(), loc.size());
+            tx.device_used                  = encodeCategory(CATEGORY_DEVICE_USED, du.data(), du.size());
+            tx.is_fraud                     = (fraud_s == "True" || fraud_s == "true");
+            tx.fraud_type                   = encodeCategory(CATEGORY_FRAUD_TYPE, ft.data(), ft.size());
+            tx.time_since_last_transaction  = parseNullableDouble(tsl.data(), tsl.size());
+            tx.spending_deviation_score     = parseRequiredDouble(sds_s.data(), sds_s.size());
+            tx.velocity_score               = parseRequiredDouble(vs_s.data(), vs_s.size());
+            tx.geo_anomaly_score            = parseRequiredDouble(gas_s.data(), gas_s.size());
+            tx.payment_channel              = encodeCategory(CATEGORY_PAYMENT_CHANNEL, pc.data(), pc.size());
+            tx.ip_address                   = parseIPv4(ip.data(), ip.size());
+            text.device_hash                = std::move(dh);
+        } catch (const std::exception& e) {
+            if (rejects == nullptr) {
+                std::cerr << "Error parsing " << inFile << ": line " << in.get_file_line() << ": " << e.what() << std::endl;
+                return;
+            }
+            rejects->record(inFile, in.get_file_line(), classifyParseError(e), e.what(), nullptr, 0);
+            continue;
+        }
+
+        txQueue.push(QueuedTransaction{std::move(tx), std::move(text)});
+    }
+}
+
+void parserWorker(const std::string& inFile, int threadCount, bool useLegacyCsvReader, CsvRejectLog* rejects) {
+    // A directory or glob is converted file by file into one JSON array.
+    std::string* paths = nullptr;
+    if (rejects != nullptr) rejects->resetCounts();
+    int fileCount = expandCsvSources(inFile, paths);
+    if (fileCount == 0) {
+        std::cerr << "No CSV files match " << inFile << std::endl;
     }
+    for (int i = 0; i < fileCount; ++i) {
+        if (useLegacyCsvReader) {
+            legacyParseFile(paths[i], rejects);
+        } else {
+            mappedParseFile(paths[i], threadCount, rejects);
+        }
+    }
+    delete[] paths;
     txQueue.finish();
 }
 
@@ -53,34 +149,16 @@ void writerWorker(const std::string& outFile) {
         std::perror("fopen");
         return;
     }
+    // FileWriteStream buffers on its own; handing the same memory to setvbuf
+    // as well let stdio overwrite pending output once the file passed 1 MB.
     static char writeBuf[1<<20];
-    std::setvbuf(fp, writeBuf, _IOFBF, sizeof(writeBuf));
     rapidjson::FileWriteStream os(fp, writeBuf, sizeof(writeBuf));
     rapidjson::PrettyWriter<rapidjson::FileWriteStream> writer(os);
 
     writer.StartArray();
-    Transaction tx;
-    while (txQueue.pop(tx)) {
-        writer.StartObject();
-        writer.Key("transaction_id");           writer.String(tx.transaction_id.c_str());
-        writer.Key("timestamp");                writer.String(tx.timestamp.c_str());
-        writer.Key("sender_account");           writer.String(tx.sender_account.c_str());
-        writer.Key("receiver_account");         writer.String(tx.receiver_account.c_str());
-        writer.Key("amount");                   writer.Double(tx.amount);
-        writer.Key("transaction_type");         writer.String(tx.transaction_type.c_str());
-        writer.Key("merchant_category");        writer.String(tx.merchant_category.c_str());
-        writer.Key("location");                 writer.String(tx.location.c_str());
-        writer.Key("device_used");              writer.String(tx.device_used.c_str());
-        writer.Key("is_fraud");                 writer.Bool(tx.is_fraud);
-        writer.Key("fraud_type");               writer.String(tx.fraud_type.c_str());
-        writer.Key("time_since_last_transaction"); writer.String(tx.time_since_last_transaction.c_str());
-        writer.Key("spending_deviation_score"); writer.Double(tx.spending_deviation_score);
-        writer.Key("velocity_score");           writer.Double(tx.velocity_score);
-        writer.Key("geo_anomaly_score");        writer.Double(tx.geo_anomaly_score);
-        writer.Key("payment_channel");          writer.String(tx.payment_channel.c_str());
-        writer.Key("ip_address");               writer.String(tx.ip_address.c_str());
-        writer.Key("device_hash");              writer.String(tx.device_hash.c_str());
-        writer.EndObject();
+    QueuedTransaction row;
+    while (txQueue.pop(row)) {
+        writeTransactionObject(writer, row.tx, row.text);
 
         os.Put('\n');
     }
@@ -88,7 +166,9 @@ void writerWorker(const std::string& outFile) {
     std::fclose(fp);
 }
 
-void saveTransactionsToJson(const TransactionArray& transactions, const std::string& outFile) {
+// Records is a TransactionArray or a TransactionArrayView over one.
+template <typename Records>
+static void saveRecordsToJson(const Records& transactions, const std::string& outFile, CsvColumnSet columns) {
     FILE* fp = std::fopen(outFile.c_str(), "wb");
     if (!fp) {
         std::perror(("Error opening file for writing: " + outFile).c_str());
@@ -103,28 +183,121 @@ void saveTransactionsToJson(const TransactionArray& transactions, const std::str
     for (int i = 0; i < transactions.getSize(); ++i) {
         const Transaction* tx = transactions.getTransaction(i);
         if (tx == nullptr) continue;
+        writeTransactionObject(writer, *tx, transactions.getText(*tx), columns);
+    }
+    writer.EndArray();
+    std::fclose(fp);
+}
+
+void saveTransactionsToJson(const TransactionArray& transactions, const std::string& outFile, CsvColumnSet columns) {
+    saveRecordsToJson(transactions, outFile, columns);
+}
+
+void saveTransactionsToJson(const TransactionArrayView& transactions, const std::string& outFile, CsvColumnSet columns) {
+    saveRecordsToJson(transactions, outFile, columns);
+}
+
+void saveTransactionsToJson(const TransactionStore& transactions, const std::string& outFile, CsvColumnSet columns) {
+    FILE* fp = std::fopen(outFile.c_str(), "wb");
+    if (!fp) {
+        std::perror(("Error opening file for writing: " + outFile).c_str());
+        return;
+    }
+
+    char writeBuf[1 << 20];
+    rapidjson::FileWriteStream os(fp, writeBuf, sizeof(writeBuf));
+    rapidjson::PrettyWriter<rapidjson::FileWriteStream> writer(os);
 
-        writer.StartObject();
-        writer.Key("transaction_id");           writer.String(tx->transaction_id.c_str());
-        writer.Key("timestamp");                writer.String(tx->timestamp.c_str());
-        writer.Key("sender_account");           writer.String(tx->sender_account.c_str());
-        writer.Key("receiver_account");         writer.String(tx->receiver_account.c_str());
-        writer.Key("amount");                   writer.Double(tx->amount);
-        writer.Key("transaction_type");         writer.String(tx->transaction_type.c_str());
-        writer.Key("merchant_category");        writer.String(tx->merchant_category.c_str());
-        writer.Key("location");                 writer.String(tx->location.c_str());
-        writer.Key("device_used");              writer.String(tx->device_used.c_str());
-        writer.Key("is_fraud");                 writer.Bool(tx->is_fraud);
-        writer.Key("fraud_type");               writer.String(tx->fraud_type.c_str());
-        writer.Key("time_since_last_transaction"); writer.String(tx->time_since_last_transaction.c_str());
-        writer.Key("spending_deviation_score"); writer.Double(tx->spending_deviation_score);
-        writer.Key("velocity_score");           writer.Double(tx->velocity_score);
-        writer.Key("geo_anomaly_score");        writer.Double(tx->geo_anomaly_score);
-        writer.Key("payment_channel");          writer.String(tx->payment_channel.c_str());
-        writer.Key("ip_address");               writer.String(tx->ip_address.c_str());
-        writer.Key("device_hash");              writer.String(tx->device_hash.c_str());
-        writer.EndObject();
+    writer.StartArray();
+    for (int i = 0; i < transactions.getSize(); ++i) {
+        writeTransactionObject(writer, transactions.getTransaction(i), transactions.getText(i), columns);
     }
     writer.EndArray();
     std::fclose(fp);
-}
\ No newline at end of file
+}
+
+struct TransactionJsonWriter::Impl {
+    FILE* fp;
+    char buffer[1 << 16];
+    rapidjson::FileWriteStream stream;
+    rapidjson::PrettyWriter<rapidjson::FileWriteStream> writer;
+
+    explicit Impl(FILE* f) : fp(f), stream(f, buffer, sizeof(buffer)), writer(stream) {}
+};
+
+TransactionJsonWriter::TransactionJsonWriter() : impl(nullptr) {}
+
+TransactionJsonWriter::~TransactionJsonWriter() {
+    close();
+}
+
+bool TransactionJsonWriter::open(const std::string& outFile) {
+    close();
+    FILE* fp = std::fopen(outFile.c_str(), "wb");
+    if (!fp) {
+        std::perror(("Error opening file for writing: " + outFile).c_str());
+        return false;
+    }
+    impl = new Impl(fp);
+    impl->writer.StartArray();
+    return true;
+}
+
+void TransactionJsonWriter::write(const Transaction& tx, const TransactionTextView& text) {
+    if (impl) writeTransactionObject(impl->writer, tx, text);
+}
+
+void TransactionJsonWriter::close() {
+    if (!impl) return;
+    impl->writer.EndArray();
+    impl->stream.Flush();
+    std::fclose(impl->fp);
+    delete impl;
+    impl = nullptr;
+}
+
+void writeTransactionCsvHeader(FILE* fp) {
+    for (int c = 0; c < CSV_COLUMN_COUNT; ++c) {
+        std::fputs(CSV_COLUMN_NAMES[c], fp);
+        std::fputc(c + 1 < CSV_COLUMN_COUNT ? ',' : '\n', fp);
+    }
+}
+
+// Text that came from a quoted field may hold a delimiter or a quote; it is
+// written back quoted, with "" for each quote, so the row reads back as one.
+static void putCsvText(FILE* fp, std::string_view value, char after) {
+    if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+        std::fwrite(value.data(), 1, value.size(), fp);
+    } else {
+        std::fputc('"', fp);
+        for (char ch : value) {
+            if (ch == '"') std::fputc('"', fp);
+            std::fputc(ch, fp);
+        }
+        std::fputc('"', fp);
+    }
+    std::fputc(after, fp);
+}
+
+void writeTransactionCsvRow(FILE* fp, const Transaction& tx, const TransactionTextView& text) {
+    char timestamp[FIELD_TEXT_CAPACITY], sinceLast[FIELD_TEXT_CAPACITY], ip[FIELD_TEXT_CAPACITY];
+    formatTimestampMicros(tx.timestamp, timestamp);
+    formatNullableDouble(tx.time_since_last_transaction, sinceLast);
+    formatIPv4(tx.ip_address, ip);
+    putCsvText(fp, text.transaction_id, ',');
+    std::fprintf(fp, "%s,", timestamp);
+    putCsvText(fp, text.sender_account, ',');
+    putCsvText(fp, text.receiver_account, ',');
+    std::fprintf(fp, "%.17g,", tx.amount);
+    putCsvText(fp, categoryName(CATEGORY_TRANSACTION_TYPE, tx.transaction_type), ',');
+    putCsvText(fp, categoryName(CATEGORY_MERCHANT_CATEGORY, tx.merchant_category), ',');
+    putCsvText(fp, categoryName(CATEGORY_LOCATION, tx.location), ',');
+    putCsvText(fp, categoryName(CATEGORY_DEVICE_USED, tx.device_used), ',');
+    std::fputs(tx.is_fraud ? "True," : "False,", fp);
+    putCsvText(fp, categoryName(CATEGORY_FRAUD_TYPE, tx.fraud_type), ',');
+    std::fprintf(fp, "%s,%.17g,%.17g,%.17g,", sinceLast,
+                 tx.spending_deviation_score, tx.velocity_score, tx.geo_anomaly_score);
+    putCsvText(fp, categoryName(CATEGORY_PAYMENT_CHANNEL, tx.payment_channel), ',');
+    std::fprintf(fp, "%s,", ip);
+    putCsvText(fp, text.device_hash, '\n');
+}
@@ -6,8 +6,12 @@
 #include <mutex>
 #include <condition_variable>
 #include <queue>
+#include <cstdio>
 #include "transaction.h"
 #include "custom_data_structures.h"
+#include "transaction_store.h"
+#include "fast_csv_reader.h"
+#include "csv_reject_log.h"
 
 
 template<typename T>
@@ -41,13 +45,57 @@ public:
     }
 };
 
-extern ThreadSafeQueue<Transaction> txQueue;
+// A row on its way from the parser thread to the writer thread.
+struct QueuedTransaction {
+    Transaction tx;
+    TransactionText text;
+};
+
+extern ThreadSafeQueue<QueuedTransaction> txQueue;
 
-void parserWorker(const std::string& inFile);
+// Parses the memory-mapped file in line-aligned chunks on threadCount
+// threads (0 = every core); rows are still queued in file order. inFile may
+// also be a directory or glob, whose files are queued one after another.
+// useLegacyCsvReader falls back to single-threaded io::CSVReader. With
+// rejects, malformed rows are recorded there and left out of the output
+// instead of ending the conversion at the first one.
+void parserWorker(const std::string& inFile, int threadCount = 1, bool useLegacyCsvReader = false,
+                  CsvRejectLog* rejects = nullptr);
 
 void writerWorker(const std::string& outFile);
 
-void saveTransactionsToJson(const TransactionArray& transactions, const std::string& outFile);
+// Only the given columns are written; pass the manager's loaded columns
+// after a projected load.
+void saveTransactionsToJson(const TransactionArray& transactions, const std::string& outFile,
+                            CsvColumnSet columns = ALL_CSV_COLUMNS);
+void saveTransactionsToJson(const TransactionStore& transactions, const std::string& outFile,
+                            CsvColumnSet columns = ALL_CSV_COLUMNS);
+// In the view's order.
+void saveTransactionsToJson(const TransactionArrayView& transactions, const std::string& outFile,
+                            CsvColumnSet columns = ALL_CSV_COLUMNS);
+
+// Writes a JSON array one transaction at a time, for results that are too
+// large to collect in memory first (streaming mode).
+class TransactionJsonWriter {
+private:
+    struct Impl;
+    Impl* impl;
+
+public:
+    TransactionJsonWriter();
+    ~TransactionJsonWriter();
+    TransactionJsonWriter(const TransactionJsonWriter&) = delete;
+    TransactionJsonWriter& operator=(const TransactionJsonWriter&) = delete;
+
+    bool open(const std::string& outFile);
+    void write(const Transaction& tx, const TransactionTextView& text);
+    void close();
+};
+
+// CSV rows in CSV_COLUMN_NAMES order; doubles round-trip exactly, and text
+// holding a comma, quote or line break is quoted per RFC 4180.
+void writeTransactionCsvHeader(FILE* fp);
+void writeTransactionCsvRow(FILE* fp, const Transaction& tx, const TransactionTextView& text);
 
 
 #endif
\ No newline at end of file
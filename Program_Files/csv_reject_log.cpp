@@ -0,0 +1,96 @@
+#include "csv_reject_log.h"
+#include <iostream>
+#include "third_party/fast-cpp-csv-parser/csv.h"
+
+CsvRejectLog::CsvRejectLog() : out(nullptr) {
+    resetCounts();
+}
+
+CsvRejectLog::~CsvRejectLog() {
+    close();
+}
+
+bool CsvRejectLog::open(const std::string& filePath) {
+    close();
+    out = std::fopen(filePath.c_str(), "w");
+    if (out == nullptr) {
+        std::perror(("Error opening reject file " + filePath).c_str());
+        return false;
+    }
+    path = filePath;
+    std::fputs("source\tline\terror\tmessage\trow\n", out);
+    return true;
+}
+
+void CsvRejectLog::close() {
+    if (out != nullptr) {
+        std::fclose(out);
+        out = nullptr;
+    }
+}
+
+void CsvRejectLog::record(const std::string& source, long line, ParseErrorKind kind, const std::string& message,
+                          const char* text, std::size_t length) {
+    std::lock_guard<std::mutex> guard(lock);
+    counts[static_cast<int>(kind)]++;
+    if (out != nullptr) {
+        std::fprintf(out, "%s\t%ld\t%s\t%s\t", source.c_str(), line, parseErrorKindName(kind), message.c_str());
+        if (length > 0) std::fwrite(text, 1, length, out);
+        std::fputc('\n', out);
+        std::fflush(out);
+    }
+}
+
+void CsvRejectLog::resetCounts() {
+    std::lock_guard<std::mutex> guard(lock);
+    for (int i = 0; i < static_cast<int>(ParseErrorKind::COUNT); ++i) {
+        counts[i] = 0;
+    }
+}
+
+long CsvRejectLog::getCount(ParseErrorKind kind) const {
+    std::lock_guard<std::mutex> guard(lock);
+    return counts[static_cast<int>(kind)];
+}
+
+long CsvRejectLog::getTotal() const {
+    long total = 0;
+    for (int i = 0; i < static_cast<int>(ParseErrorKind::COUNT); ++i) {
+        total += getCount(static_cast<ParseErrorKind>(i));
+    }
+    return total;
+}
+
+void CsvRejectLog::printSummary(const std::string& operation) const {
+    long total = getTotal();
+    if (total == 0) {
+        return;
+    }
+    std::cout << "⚠️  " << operation << ": skipped " << total << " malformed row(s)";
+    if (!path.empty()) {
+        std::cout << ", written to " << path;
+    }
+    std::cout << "\n";
+    for (int i = 0; i < static_cast<int>(ParseErrorKind::COUNT); ++i) {
+        long count = getCount(static_cast<ParseErrorKind>(i));
+        if (count > 0) {
+            std::cout << "    " << parseErrorKindName(static_cast<ParseErrorKind>(i)) << ": " << count << "\n";
+        }
+    }
+}
+
+ParseErrorKind classifyParseError(const std::exception& e) {
+    const ParseError* parseError = dynamic_cast<const ParseError*>(&e);
+    if (parseError != nullptr) {
+        return parseError->getKind();
+    }
+    // io::CSVReader reports its own column count errors.
+    if (dynamic_cast<const io::error::too_few_columns*>(&e) != nullptr ||
+        dynamic_cast<const io::error::too_many_columns*>(&e) != nullptr) {
+        return ParseErrorKind::ROW_SHAPE;
+    }
+    if (dynamic_cast<const io::error::escaped_string_not_closed*>(&e) != nullptr) {
+        return ParseErrorKind::QUOTING;
+    }
+    return ParseErrorKind::OTHER;
+}
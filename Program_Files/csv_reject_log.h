@@ -0,0 +1,48 @@
+#ifndef CSV_REJECT_LOG_H
+#define CSV_REJECT_LOG_H
+
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include "transaction_fields.h"
+
+// Where a tolerant load puts the rows it skips. Each one is appended to the
+// reject file as a tab-separated record (source, line, error class,
+// message, raw row) and counted by ParseErrorKind. record() may be called
+// from several loader threads at once; the happy path never touches it.
+class CsvRejectLog {
+private:
+    std::FILE* out;
+    std::string path;
+    long counts[static_cast<int>(ParseErrorKind::COUNT)];
+    mutable std::mutex lock;
+
+public:
+    CsvRejectLog();
+    ~CsvRejectLog();
+    CsvRejectLog(const CsvRejectLog&) = delete;
+    CsvRejectLog& operator=(const CsvRejectLog&) = delete;
+
+    // Truncates the file and writes the header line.
+    bool open(const std::string& filePath);
+    void close();
+
+    void record(const std::string& source, long line, ParseErrorKind kind, const std::string& message,
+                const char* text, std::size_t length);
+
+    // Counts cover the records since the last resetCounts(), so every
+    // operation can report its own rejects.
+    void resetCounts();
+    long getCount(ParseErrorKind kind) const;
+    long getTotal() const;
+    const std::string& getPath() const { return path; }
+
+    // One line per error class that occurred; nothing if there were none.
+    void printSummary(const std::string& operation) const;
+};
+
+// The ParseErrorKind of an exception thrown while reading a row.
+ParseErrorKind classifyParseError(const std::exception& e);
+
+#endif
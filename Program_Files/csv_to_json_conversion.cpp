@@ -10,7 +10,7 @@ void performFullCsvToJsonConversion(const std::string& inFile, const std::string
     std::cout << "    Input CSV: " << inFile << "\n";
     std::cout << "    Output JSON: " << outFile << "\n";
 
-    std::thread parser(parserWorker, inFile);
+    std::thread parser(parserWorker, inFile, 1, false, nullptr);
     std::thread writer(writerWorker, outFile);
 
     parser.join();
@@ -1,38 +1,359 @@
 #include "custom_data_structures.h"
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <type_traits>
 
-TransactionArray::TransactionArray(int initialCapacity) : size(0) {
+static const std::size_t FIRST_ARENA_BLOCK = 64 * 1024;
+static const std::size_t LARGEST_ARENA_BLOCK = 16 * 1024 * 1024;
+
+TextArena::TextArena() : current(nullptr), used(0), capacity(0), reservedBytes(0) {}
+
+TextArena::~TextArena() {
+    release();
+}
+
+void TextArena::release() {
+    while (current != nullptr) {
+        char* previous;
+        std::memcpy(&previous, current, sizeof(previous));
+        delete[] current;
+        current = previous;
+    }
+    used = 0;
+    capacity = 0;
+    reservedBytes = 0;
+}
+
+void TextArena::startBlock(std::size_t minimum) {
+    std::size_t blockSize = capacity == 0 ? FIRST_ARENA_BLOCK : std::min(capacity * 2, LARGEST_ARENA_BLOCK);
+    if (blockSize < minimum + sizeof(char*)) {
+        blockSize = minimum + sizeof(char*);
+    }
+    char* block = new char[blockSize];
+    std::memcpy(block, &current, sizeof(current));
+    current = block;
+    used = sizeof(char*);
+    capacity = blockSize;
+    reservedBytes += blockSize;
+}
+
+char* TextArena::allocate(std::size_t length) {
+    if (current == nullptr || capacity - used < length) {
+        startBlock(length);
+    }
+    char* bytes = current + used;
+    used += length;
+    return bytes;
+}
+
+void TextArena::adopt(TextArena& other) {
+    if (other.current == nullptr) {
+        return;
+    }
+    if (current == nullptr) {
+        *this = std::move(other);
+        return;
+    }
+    // other's chain is spliced in behind the current block.
+    char* oldest = other.current;
+    char* previous;
+    while (std::memcpy(&previous, oldest, sizeof(previous)), previous != nullptr) {
+        oldest = previous;
+    }
+    std::memcpy(&previous, current, sizeof(previous));
+    std::memcpy(oldest, &previous, sizeof(previous));
+    std::memcpy(current, &other.current, sizeof(other.current));
+    reservedBytes += other.reservedBytes;
+    other.current = nullptr;
+    other.used = 0;
+    other.capacity = 0;
+    other.reservedBytes = 0;
+}
+
+TextArena::TextArena(TextArena&& other) noexcept
+    : current(other.current), used(other.used), capacity(other.capacity), reservedBytes(other.reservedBytes) {
+    other.current = nullptr;
+    other.used = 0;
+    other.capacity = 0;
+    other.reservedBytes = 0;
+}
+
+TextArena& TextArena::operator=(TextArena&& other) noexcept {
+    if (this != &other) {
+        release();
+        current = other.current;
+        used = other.used;
+        capacity = other.capacity;
+        reservedBytes = other.reservedBytes;
+        other.current = nullptr;
+        other.used = 0;
+        other.capacity = 0;
+        other.reservedBytes = 0;
+    }
+    return *this;
+}
+
+TransactionTextStore::TransactionTextStore(uint32_t initialCapacity, TextStorage textStorage)
+    : storage(textStorage), strings(nullptr), spans(nullptr), size(0), capacity(0) {
+    if (initialCapacity == 0) {
+        initialCapacity = 10;
+    }
+    allocateEntries(initialCapacity);
+}
+
+TransactionTextStore::~TransactionTextStore() {
+    delete[] strings;
+    delete[] spans;
+}
+
+void TransactionTextStore::allocateEntries(uint32_t count) {
+    if (storage == TextStorage::STRINGS) {
+        strings = new TransactionText[count];
+    } else {
+        spans = new ArenaText[count];
+    }
+    capacity = count;
+}
+
+void TransactionTextStore::reserve(uint32_t minimumCapacity) {
+    if (minimumCapacity > capacity) {
+        reallocate(minimumCapacity);
+    }
+}
+
+void TransactionTextStore::shrinkToFit() {
+    if (size < capacity) {
+        reallocate(size > 0 ? size : 1);
+    }
+}
+
+void TransactionTextStore::reallocate(uint32_t newCapacity) {
+    if (storage == TextStorage::STRINGS) {
+        TransactionText* newData = new TransactionText[newCapacity];
+        for (uint32_t i = 0; i < size; ++i) {
+            newData[i] = std::move(strings[i]);
+        }
+        delete[] strings;
+        strings = newData;
+    } else {
+        ArenaText* newSpans = new ArenaText[newCapacity];
+        std::memcpy(newSpans, spans, sizeof(ArenaText) * size);
+        delete[] spans;
+        spans = newSpans;
+    }
+    capacity = newCapacity;
+}
+
+uint32_t TransactionTextStore::add(const TransactionTextView& text) {
+    if (size == capacity) {
+        reallocate(capacity > 0 ? capacity * 2 : 10);
+    }
+    if (storage == TextStorage::STRINGS) {
+        strings[size] = text.toText();
+        return size++;
+    }
+    const std::string_view fields[4] = {text.transaction_id, text.sender_account, text.receiver_account, text.device_hash};
+    ArenaText& span = spans[size];
+    char* p = arena.allocate(fields[0].size() + fields[1].size() + fields[2].size() + fields[3].size());
+    span.base = p;
+    for (int f = 0; f < 4; ++f) {
+        std::memcpy(p, fields[f].data(), fields[f].size());
+        p += fields[f].size();
+        span.lengths[f] = static_cast<uint32_t>(fields[f].size());
+    }
+    return size++;
+}
+
+uint32_t TransactionTextStore::add(TransactionText&& text) {
+    if (storage == TextStorage::ARENA) {
+        return add(TransactionTextView(text));
+    }
+    if (size == capacity) {
+        reallocate(capacity > 0 ? capacity * 2 : 10);
+    }
+    strings[size] = std::move(text);
+    return size++;
+}
+
+uint32_t TransactionTextStore::adopt(TransactionTextStore& other) {
+    const uint32_t first = size;
+    if (size + other.size > capacity) {
+        reallocate(std::max(capacity * 2, size + other.size));
+    }
+    if (other.storage != storage) {
+        for (uint32_t i = 0; i < other.size; ++i) {
+            add(other[i]);
+        }
+    } else if (storage == TextStorage::STRINGS) {
+        for (uint32_t i = 0; i < other.size; ++i) {
+            strings[size + i] = std::move(other.strings[i]);
+        }
+        size += other.size;
+    } else {
+        std::memcpy(spans + size, other.spans, sizeof(ArenaText) * other.size);
+        arena.adopt(other.arena);
+        size += other.size;
+    }
+    other.size = 0;
+    return first;
+}
+
+std::size_t TransactionTextStore::getMemoryBytes() const {
+    if (storage == TextStorage::ARENA) {
+        return sizeof(ArenaText) * capacity + arena.getReservedBytes();
+    }
+    // Strings of up to 15 characters are held inside the std::string itself.
+    std::size_t bytes = sizeof(TransactionText) * capacity;
+    for (uint32_t i = 0; i < size; ++i) {
+        const TransactionText& text = strings[i];
+        for (const std::string* s : {&text.transaction_id, &text.sender_account, &text.receiver_account, &text.device_hash}) {
+            if (s->capacity() > 15) bytes += s->capacity() + 1;
+        }
+    }
+    return bytes;
+}
+
+// A copy packs the other store's text into a fresh arena.
+void TransactionTextStore::copyFrom(const TransactionTextStore& other) {
+    storage = other.storage;
+    size = 0;
+    allocateEntries(other.capacity);
+    for (uint32_t i = 0; i < other.size; ++i) {
+        add(other[i]);
+    }
+}
+
+TransactionTextStore::TransactionTextStore(const TransactionTextStore& other)
+    : storage(other.storage), strings(nullptr), spans(nullptr), size(0), capacity(0) {
+    copyFrom(other);
+}
+
+TransactionTextStore& TransactionTextStore::operator=(const TransactionTextStore& other) {
+    if (this != &other) {
+        delete[] strings;
+        delete[] spans;
+        strings = nullptr;
+        spans = nullptr;
+        arena = TextArena();
+        copyFrom(other);
+    }
+    return *this;
+}
+
+TransactionTextStore::TransactionTextStore(TransactionTextStore&& other) noexcept
+    : storage(other.storage), strings(other.strings), spans(other.spans), arena(std::move(other.arena)),
+      size(other.size), capacity(other.capacity) {
+    other.strings = nullptr;
+    other.spans = nullptr;
+    other.size = 0;
+    other.capacity = 0;
+}
+
+TransactionTextStore& TransactionTextStore::operator=(TransactionTextStore&& other) noexcept {
+    if (this != &other) {
+        delete[] strings;
+        delete[] spans;
+        storage = other.storage;
+        strings = other.strings;
+        spans = other.spans;
+        arena = std::move(other.arena);
+        size = other.size;
+        capacity = other.capacity;
+        other.strings = nullptr;
+        other.spans = nullptr;
+        other.size = 0;
+        other.capacity = 0;
+    }
+    return *this;
+}
+
+// Records are copied with memcpy and their storage freed without running
+// destructors.
+static_assert(std::is_trivially_copyable<Transaction>::value && std::is_trivially_destructible<Transaction>::value,
+              "TransactionArray keeps records in raw storage");
+
+static Transaction* allocateRecords(int count) {
+    return static_cast<Transaction*>(::operator new(sizeof(Transaction) * static_cast<std::size_t>(count)));
+}
+
+TransactionArray::TransactionArray(int initialCapacity, TextStorage textStorage)
+    : size(0), texts(initialCapacity > 0 ? static_cast<uint32_t>(initialCapacity) : 10u, textStorage) {
     if (initialCapacity <= 0) {
         initialCapacity = 10;
     }
     capacity = initialCapacity;
-    data = new Transaction[capacity];
+    data = allocateRecords(capacity);
 }
 
 TransactionArray::~TransactionArray() {
-    delete[] data;
+    ::operator delete(data);
     data = nullptr;
     size = 0;
     capacity = 0;
 }
 
-void TransactionArray::expandCapacity() {
-    int newCapacity = capacity * 2;
-    Transaction* newData = new Transaction[newCapacity];
-    for (int i = 0; i < size; ++i) {
-        newData[i] = std::move(data[i]);
+void TransactionArray::reallocate(int newCapacity) {
+    Transaction* newData = allocateRecords(newCapacity);
+    if (size > 0) {
+        std::memcpy(static_cast<void*>(newData), data, sizeof(Transaction) * static_cast<std::size_t>(size));
     }
-    delete[] data;
+    ::operator delete(data);
     data = newData;
     capacity = newCapacity;
-    std::cout << "Debug: TransactionArray capacity expanded to " << capacity << std::endl;
 }
 
-void TransactionArray::addTransaction(const Transaction& tx) {
+void TransactionArray::expandCapacity() {
+    reallocate(capacity * 2);
+}
+
+void TransactionArray::reserve(int minimumCapacity) {
+    if (minimumCapacity > capacity) {
+        reallocate(minimumCapacity);
+    }
+    texts.reserve(static_cast<uint32_t>(minimumCapacity));
+}
+
+void TransactionArray::shrinkToFit() {
+    if (size < capacity) {
+        reallocate(size > 0 ? size : 1);
+    }
+    texts.shrinkToFit();
+}
+
+void TransactionArray::addTransaction(const Transaction& tx, const TransactionTextView& text) {
+    if (size == capacity) {
+        expandCapacity();
+    }
+    Transaction* slot = new (data + size) Transaction(tx);
+    slot->textRow = texts.add(text);
+    size++;
+}
+
+void TransactionArray::addTransaction(Transaction&& tx, TransactionText&& text) {
     if (size == capacity) {
         expandCapacity();
     }
-    data[size++] = tx;
+    Transaction* slot = new (data + size) Transaction(std::move(tx));
+    slot->textRow = texts.add(std::move(text));
+    size++;
+}
+
+void TransactionArray::adoptRows(TransactionArray& rows, int count) {
+    if (count > rows.size) {
+        count = rows.size;
+    }
+    if (size + count > capacity) {
+        reallocate(std::max(capacity * 2, size + count));
+    }
+    const uint32_t firstText = texts.adopt(rows.texts);
+    for (int i = 0; i < count; ++i) {
+        Transaction* slot = new (data + size) Transaction(rows.data[i]);
+        slot->textRow += firstText;
+        size++;
+    }
+    rows.size = 0;
 }
 
 int TransactionArray::getSize() const {
@@ -63,29 +384,27 @@ const Transaction* TransactionArray::getDataPointer() const {
     return data;
 }
 
-TransactionArray::TransactionArray(const TransactionArray& other) : size(other.size), capacity(other.capacity) {
-    data = new Transaction[capacity];
-    for (int i = 0; i < size; ++i) {
-        data[i] = other.data[i];
-    }
+TransactionArray::TransactionArray(const TransactionArray& other)
+    : size(other.size), capacity(other.capacity), texts(other.texts) {
+    data = allocateRecords(capacity);
+    std::memcpy(static_cast<void*>(data), other.data, sizeof(Transaction) * static_cast<std::size_t>(size));
 }
 
 TransactionArray& TransactionArray::operator=(const TransactionArray& other) {
     if (this != &other) {
-        delete[] data;
+        ::operator delete(data);
 
         size = other.size;
         capacity = other.capacity;
-        data = new Transaction[capacity];
-        for (int i = 0; i < size; ++i) {
-            data[i] = other.data[i];
-        }
+        texts = other.texts;
+        data = allocateRecords(capacity);
+        std::memcpy(static_cast<void*>(data), other.data, sizeof(Transaction) * static_cast<std::size_t>(size));
     }
     return *this;
 }
 
 TransactionArray::TransactionArray(TransactionArray&& other) noexcept
-    : data(other.data), size(other.size), capacity(other.capacity) {
+    : data(other.data), size(other.size), capacity(other.capacity), texts(std::move(other.texts)) {
     other.data = nullptr;
     other.size = 0;
     other.capacity = 0;
@@ -93,11 +412,12 @@ TransactionArray::TransactionArray(TransactionArray&& other) noexcept
 
 TransactionArray& TransactionArray::operator=(TransactionArray&& other) noexcept {
     if (this != &other) {
-        delete[] data;
+        ::operator delete(data);
 
         data = other.data;
         size = other.size;
         capacity = other.capacity;
+        texts = std::move(other.texts);
 
         other.data = nullptr;
         other.size = 0;
@@ -106,23 +426,166 @@ TransactionArray& TransactionArray::operator=(TransactionArray&& other) noexcept
     return *this;
 }
 
+TransactionArrayView::TransactionArrayView() : array(nullptr), rows(nullptr), size(0) {}
+
+TransactionArrayView::TransactionArrayView(const TransactionArray& array, int* rows)
+    : array(&array), rows(rows), size(array.getSize()) {}
+
+TransactionArrayView::~TransactionArrayView() {
+    delete[] rows;
+}
+
+TransactionArrayView::TransactionArrayView(TransactionArrayView&& other) noexcept
+    : array(other.array), rows(other.rows), size(other.size) {
+    other.array = nullptr;
+    other.rows = nullptr;
+    other.size = 0;
+}
 
-TransactionLinkedList::TransactionLinkedList() : head(nullptr), tail(nullptr), size(0) {}
+TransactionArrayView& TransactionArrayView::operator=(TransactionArrayView&& other) noexcept {
+    if (this != &other) {
+        delete[] rows;
+        array = other.array;
+        rows = other.rows;
+        size = other.size;
+        other.array = nullptr;
+        other.rows = nullptr;
+        other.size = 0;
+    }
+    return *this;
+}
+
+
+// Slabs are raw storage and are freed without running destructors.
+static_assert(std::is_trivially_destructible<TransactionNode>::value,
+              "TransactionNodePool frees nodes without destroying them");
+
+TransactionNodePool::TransactionNodePool()
+    : slabs(nullptr), slabCount(0), slabCapacity(0), activeSlab(0), usedInSlab(0) {}
+
+TransactionNodePool::~TransactionNodePool() {
+    release();
+}
+
+void TransactionNodePool::release() {
+    for (int i = 0; i < slabCount; ++i) {
+        ::operator delete(slabs[i]);
+    }
+    delete[] slabs;
+    slabs = nullptr;
+    slabCount = 0;
+    slabCapacity = 0;
+    activeSlab = 0;
+    usedInSlab = 0;
+}
+
+TransactionNode* TransactionNodePool::allocate(const Transaction& tx) {
+    if (slabCount == 0 || usedInSlab == NODES_PER_SLAB) {
+        if (slabCount > 0) {
+            activeSlab++;
+            usedInSlab = 0;
+        }
+        // Slabs kept by reset() are refilled before new ones are made.
+        if (activeSlab == slabCount) {
+            if (slabCount == slabCapacity) {
+                slabCapacity = slabCapacity > 0 ? slabCapacity * 2 : 16;
+                TransactionNode** grown = new TransactionNode*[slabCapacity];
+                std::copy(slabs, slabs + slabCount, grown);
+                delete[] slabs;
+                slabs = grown;
+            }
+            slabs[slabCount++] = static_cast<TransactionNode*>(::operator new(sizeof(TransactionNode) * NODES_PER_SLAB));
+        }
+    }
+    return new (slabs[activeSlab] + usedInSlab++) TransactionNode(tx);
+}
+
+void TransactionNodePool::reset() {
+    activeSlab = 0;
+    usedInSlab = 0;
+}
+
+std::size_t TransactionNodePool::getReservedBytes() const {
+    return static_cast<std::size_t>(slabCount) * NODES_PER_SLAB * sizeof(TransactionNode);
+}
+
+TransactionNodePool::TransactionNodePool(TransactionNodePool&& other) noexcept
+    : slabs(other.slabs), slabCount(other.slabCount), slabCapacity(other.slabCapacity),
+      activeSlab(other.activeSlab), usedInSlab(other.usedInSlab) {
+    other.slabs = nullptr;
+    other.slabCount = 0;
+    other.slabCapacity = 0;
+    other.activeSlab = 0;
+    other.usedInSlab = 0;
+}
+
+TransactionNodePool& TransactionNodePool::operator=(TransactionNodePool&& other) noexcept {
+    if (this != &other) {
+        release();
+        slabs = other.slabs;
+        slabCount = other.slabCount;
+        slabCapacity = other.slabCapacity;
+        activeSlab = other.activeSlab;
+        usedInSlab = other.usedInSlab;
+        other.slabs = nullptr;
+        other.slabCount = 0;
+        other.slabCapacity = 0;
+        other.activeSlab = 0;
+        other.usedInSlab = 0;
+    }
+    return *this;
+}
+
+
+TransactionLinkedList::TransactionLinkedList(TextStorage textStorage, NodeAllocation nodeAllocation)
+    : head(nullptr), tail(nullptr), size(0), allocation(nodeAllocation), texts(10, textStorage) {}
 
 TransactionLinkedList::~TransactionLinkedList() {
-    TransactionNode* current = head;
-    while (current != nullptr) {
-        TransactionNode* nextNode = current->next;
-        delete current;
-        current = nextNode;
+    // Pooled nodes go with the pool's slabs.
+    if (allocation == NodeAllocation::HEAP) {
+        releaseNodes();
+    }
+}
+
+TransactionNode* TransactionLinkedList::createNode(const Transaction& tx) {
+    if (allocation == NodeAllocation::POOL) {
+        return pool.allocate(tx);
+    }
+    return new TransactionNode(tx);
+}
+
+void TransactionLinkedList::releaseNodes() {
+    if (allocation == NodeAllocation::POOL) {
+        pool.reset();
+    } else {
+        TransactionNode* current = head;
+        while (current != nullptr) {
+            TransactionNode* nextNode = current->next;
+            delete current;
+            current = nextNode;
+        }
     }
     head = nullptr;
     tail = nullptr;
     size = 0;
 }
 
-void TransactionLinkedList::addTransaction(const Transaction& tx) {
-    TransactionNode* newNode = new TransactionNode(tx);
+void TransactionLinkedList::addTransaction(const Transaction& tx, const TransactionTextView& text) {
+    TransactionNode* newNode = createNode(tx);
+    newNode->data.textRow = texts.add(text);
+    if (head == nullptr) {
+        head = newNode;
+        tail = newNode;
+    } else {
+        tail->next = newNode;
+        tail = newNode;
+    }
+    size++;
+}
+
+void TransactionLinkedList::addTransaction(Transaction&& tx, TransactionText&& text) {
+    TransactionNode* newNode = createNode(tx);
+    newNode->data.textRow = texts.add(std::move(text));
     if (head == nullptr) {
         head = newNode;
         tail = newNode;
@@ -133,6 +596,46 @@ void TransactionLinkedList::addTransaction(const Transaction& tx) {
     size++;
 }
 
+TransactionNode* TransactionLinkedList::insertAfter(TransactionNode* position, const Transaction& tx, const TransactionTextView& text) {
+    TransactionNode* newNode = createNode(tx);
+    newNode->data.textRow = texts.add(text);
+    if (position == nullptr) {
+        newNode->next = head;
+        head = newNode;
+    } else {
+        newNode->next = position->next;
+        position->next = newNode;
+    }
+    if (newNode->next == nullptr) {
+        tail = newNode;
+    }
+    size++;
+    return newNode;
+}
+
+void TransactionLinkedList::relink(TransactionNode* const* nodes) {
+    if (size == 0) {
+        return;
+    }
+    for (int i = 0; i + 1 < size; ++i) {
+        nodes[i]->next = nodes[i + 1];
+    }
+    nodes[size - 1]->next = nullptr;
+    head = nodes[0];
+    tail = nodes[size - 1];
+}
+
+void TransactionLinkedList::adoptSortedChain(TransactionNode* newHead) {
+    head = newHead;
+    tail = nullptr;
+    int count = 0;
+    for (TransactionNode* node = newHead; node; node = node->next) {
+        tail = node;
+        ++count;
+    }
+    size = count;
+}
+
 int TransactionLinkedList::getSize() const {
     return size;
 }
@@ -161,78 +664,272 @@ const Transaction* TransactionLinkedList::getTransaction(int index) const {
     return &(current->data);
 }
 
-TransactionLinkedList::TransactionLinkedList(const TransactionLinkedList& other) : head(nullptr), tail(nullptr), size(0) {
-    if (other.head == nullptr) {
-        return;
+void TransactionLinkedList::copyNodesFrom(const TransactionLinkedList& other) {
+    for (TransactionNode* currentOther = other.head; currentOther != nullptr; currentOther = currentOther->next) {
+        TransactionNode* newNode = createNode(currentOther->data);
+        if (head == nullptr) {
+            head = newNode;
+        } else {
+            tail->next = newNode;
+        }
+        tail = newNode;
+        size++;
     }
+}
 
-    TransactionNode* currentOther = other.head;
-    head = new TransactionNode(currentOther->data);
-    tail = head;
-    size = 1;
+TransactionLinkedList::TransactionLinkedList(const TransactionLinkedList& other)
+    : head(nullptr), tail(nullptr), size(0), allocation(other.allocation), texts(other.texts) {
+    copyNodesFrom(other);
+}
 
-    currentOther = currentOther->next;
-    while (currentOther != nullptr) {
-        tail->next = new TransactionNode(currentOther->data);
-        tail = tail->next;
-        currentOther = currentOther->next;
-        size++;
+TransactionLinkedList& TransactionLinkedList::operator=(const TransactionLinkedList& other) {
+    if (this != &other) {
+        releaseNodes();
+        allocation = other.allocation;
+        texts = other.texts;
+        copyNodesFrom(other);
     }
+    return *this;
 }
 
-TransactionLinkedList& TransactionLinkedList::operator=(const TransactionLinkedList& other) {
+TransactionLinkedList::TransactionLinkedList(TransactionLinkedList&& other) noexcept
+    : head(other.head), tail(other.tail), size(other.size), allocation(other.allocation),
+      pool(std::move(other.pool)), texts(std::move(other.texts)) {
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+}
+
+TransactionLinkedList& TransactionLinkedList::operator=(TransactionLinkedList&& other) noexcept {
     if (this != &other) {
-        TransactionNode* current = head;
-        while (current != nullptr) {
-            TransactionNode* nextNode = current->next;
-            delete current;
-            current = nextNode;
+        if (allocation == NodeAllocation::HEAP) {
+            releaseNodes();
         }
-        head = nullptr;
-        tail = nullptr;
-        size = 0;
-
-        if (other.head != nullptr) {
-            TransactionNode* currentOther = other.head;
-            head = new TransactionNode(currentOther->data);
-            tail = head;
-            size = 1;
-
-            currentOther = currentOther->next;
-            while (currentOther != nullptr) {
-                tail->next = new TransactionNode(currentOther->data);
-                tail = tail->next;
-                currentOther = currentOther->next;
-                size++;
+
+        head = other.head;
+        tail = other.tail;
+        size = other.size;
+        allocation = other.allocation;
+        pool = std::move(other.pool);
+        texts = std::move(other.texts);
+
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.size = 0;
+    }
+    return *this;
+}
+
+
+TransactionUnrolledList::TransactionUnrolledList(TextStorage textStorage)
+    : head(nullptr), tail(nullptr), size(0), blockCount(0), texts(10, textStorage) {}
+
+TransactionUnrolledList::~TransactionUnrolledList() {
+    releaseBlocks();
+}
+
+void TransactionUnrolledList::releaseBlocks() {
+    TransactionBlock* current = head;
+    while (current != nullptr) {
+        TransactionBlock* nextBlock = current->next;
+        delete current;
+        current = nextBlock;
+    }
+    head = nullptr;
+    tail = nullptr;
+    size = 0;
+    blockCount = 0;
+}
+
+void TransactionUnrolledList::appendRecord(const Transaction& tx) {
+    if (tail == nullptr || tail->count == TransactionBlock::ROWS_PER_BLOCK) {
+        TransactionBlock* block = new TransactionBlock();
+        if (tail == nullptr) {
+            head = block;
+        } else {
+            tail->next = block;
+        }
+        tail = block;
+        blockCount++;
+    }
+    tail->rows[tail->count++] = tx;
+    size++;
+}
+
+void TransactionUnrolledList::addTransaction(const Transaction& tx, const TransactionTextView& text) {
+    Transaction record = tx;
+    record.textRow = texts.add(text);
+    appendRecord(record);
+}
+
+void TransactionUnrolledList::addTransaction(Transaction&& tx, TransactionText&& text) {
+    tx.textRow = texts.add(std::move(text));
+    appendRecord(tx);
+}
+
+TransactionBlock* TransactionUnrolledList::insertAt(TransactionBlock* block, int slot, const Transaction& tx,
+                                                    const TransactionTextView& text, int& insertedSlot) {
+    Transaction record = tx;
+    record.textRow = texts.add(text);
+    if (block == nullptr) {
+        appendRecord(record);
+        insertedSlot = tail->count - 1;
+        return tail;
+    }
+    if (block->count == TransactionBlock::ROWS_PER_BLOCK) {
+        const int half = TransactionBlock::ROWS_PER_BLOCK / 2;
+        TransactionBlock* sibling = new TransactionBlock();
+        std::copy(block->rows + half, block->rows + block->count, sibling->rows);
+        sibling->count = block->count - half;
+        block->count = half;
+        sibling->next = block->next;
+        block->next = sibling;
+        if (tail == block) {
+            tail = sibling;
+        }
+        blockCount++;
+        if (slot > half) {
+            block = sibling;
+            slot -= half;
+        }
+    }
+    std::copy_backward(block->rows + slot, block->rows + block->count, block->rows + block->count + 1);
+    block->rows[slot] = record;
+    block->count++;
+    size++;
+    insertedSlot = slot;
+    return block;
+}
+
+void TransactionUnrolledList::removeAt(int index) {
+    if (index < 0 || index >= size) {
+        std::cerr << "Error: Index out of bounds in TransactionUnrolledList::removeAt(" << index << ")\n";
+        return;
+    }
+    TransactionBlock* previous = nullptr;
+    TransactionBlock* block = head;
+    while (index >= block->count) {
+        index -= block->count;
+        previous = block;
+        block = block->next;
+    }
+    std::copy(block->rows + index + 1, block->rows + block->count, block->rows + index);
+    block->count--;
+    size--;
+
+    const int half = TransactionBlock::ROWS_PER_BLOCK / 2;
+    TransactionBlock* nextBlock = block->next;
+    if (block->count < half && nextBlock != nullptr) {
+        if (block->count + nextBlock->count <= TransactionBlock::ROWS_PER_BLOCK) {
+            std::copy(nextBlock->rows, nextBlock->rows + nextBlock->count, block->rows + block->count);
+            block->count += nextBlock->count;
+            block->next = nextBlock->next;
+            if (tail == nextBlock) {
+                tail = block;
             }
+            delete nextBlock;
+            blockCount--;
+        } else {
+            block->rows[block->count++] = nextBlock->rows[0];
+            std::copy(nextBlock->rows + 1, nextBlock->rows + nextBlock->count, nextBlock->rows);
+            nextBlock->count--;
+        }
+    } else if (block->count == 0) {
+        // Only the last block can run empty.
+        if (previous == nullptr) {
+            head = nullptr;
+        } else {
+            previous->next = nullptr;
         }
+        tail = previous;
+        delete block;
+        blockCount--;
+    }
+}
+
+TransactionBlock* TransactionUnrolledList::locate(int index, int& slot) const {
+    TransactionBlock* block = head;
+    while (index >= block->count) {
+        index -= block->count;
+        block = block->next;
+    }
+    slot = index;
+    return block;
+}
+
+Transaction* TransactionUnrolledList::getTransaction(int index) {
+    if (index < 0 || index >= size) {
+        std::cerr << "Error: Index out of bounds in TransactionUnrolledList::getTransaction(" << index << ")\n";
+        return nullptr;
+    }
+    int slot;
+    TransactionBlock* block = locate(index, slot);
+    return &block->rows[slot];
+}
+
+const Transaction* TransactionUnrolledList::getTransaction(int index) const {
+    if (index < 0 || index >= size) {
+        std::cerr << "Error: Index out of bounds in TransactionUnrolledList::getTransaction(" << index << ") const\n";
+        return nullptr;
+    }
+    int slot;
+    const TransactionBlock* block = locate(index, slot);
+    return &block->rows[slot];
+}
+
+void TransactionUnrolledList::copyBlocksFrom(const TransactionUnrolledList& other) {
+    for (const TransactionBlock* source = other.head; source != nullptr; source = source->next) {
+        TransactionBlock* block = new TransactionBlock();
+        std::copy(source->rows, source->rows + source->count, block->rows);
+        block->count = source->count;
+        if (tail == nullptr) {
+            head = block;
+        } else {
+            tail->next = block;
+        }
+        tail = block;
+        blockCount++;
+    }
+    size = other.size;
+}
+
+TransactionUnrolledList::TransactionUnrolledList(const TransactionUnrolledList& other)
+    : head(nullptr), tail(nullptr), size(0), blockCount(0), texts(other.texts) {
+    copyBlocksFrom(other);
+}
+
+TransactionUnrolledList& TransactionUnrolledList::operator=(const TransactionUnrolledList& other) {
+    if (this != &other) {
+        releaseBlocks();
+        texts = other.texts;
+        copyBlocksFrom(other);
     }
     return *this;
 }
 
-TransactionLinkedList::TransactionLinkedList(TransactionLinkedList&& other) noexcept
-    : head(other.head), tail(other.tail), size(other.size) {
+TransactionUnrolledList::TransactionUnrolledList(TransactionUnrolledList&& other) noexcept
+    : head(other.head), tail(other.tail), size(other.size), blockCount(other.blockCount),
+      texts(std::move(other.texts)) {
     other.head = nullptr;
     other.tail = nullptr;
     other.size = 0;
+    other.blockCount = 0;
 }
 
-TransactionLinkedList& TransactionLinkedList::operator=(TransactionLinkedList&& other) noexcept {
+TransactionUnrolledList& TransactionUnrolledList::operator=(TransactionUnrolledList&& other) noexcept {
     if (this != &other) {
-        TransactionNode* current = head;
-        while (current != nullptr) {
-            TransactionNode* nextNode = current->next;
-            delete current;
-            current = nextNode;
-        }
+        releaseBlocks();
 
         head = other.head;
         tail = other.tail;
         size = other.size;
+        blockCount = other.blockCount;
+        texts = std::move(other.texts);
 
         other.head = nullptr;
         other.tail = nullptr;
         other.size = 0;
+        other.blockCount = 0;
     }
     return *this;
-}
\ No newline at end of file
+}
@@ -1,31 +1,223 @@
 #ifndef CUSTOM_DATA_STRUCTURES_H
 #define CUSTOM_DATA_STRUCTURES_H
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include "transaction.h"
 
+// How a container keeps the text columns of its rows.
+enum class TextStorage {
+    STRINGS,  // a TransactionText, four std::string, per row
+    ARENA     // the characters of every row packed into a few large blocks
+};
+
+// Bump allocator for text. Each copy is appended to the current block, and
+// a new block twice the size of the last is started when it is full.
+// Nothing is freed before the arena itself, so copied bytes never move and
+// teardown is one delete per block.
+class TextArena {
+private:
+    // The first bytes of every block point to the block before it.
+    char* current;
+    std::size_t used;
+    std::size_t capacity;
+    std::size_t reservedBytes;
+    void startBlock(std::size_t minimum);
+    void release();
+
+public:
+    TextArena();
+    ~TextArena();
+    TextArena(const TextArena&) = delete;
+    TextArena& operator=(const TextArena&) = delete;
+    TextArena(TextArena&& other) noexcept;
+    TextArena& operator=(TextArena&& other) noexcept;
+
+    // length bytes that stay put until the arena is destroyed.
+    char* allocate(std::size_t length);
+    // Takes over other's blocks, so text copied into them stays where it
+    // is; new copies still go to this arena's current block.
+    void adopt(TextArena& other);
+    std::size_t getReservedBytes() const { return reservedBytes; }
+};
+
+// Append-only storage for the text of a container's rows. A row refers to
+// its entry through Transaction::textRow, so sorting or relinking the rows
+// never moves their text. With TextStorage::ARENA an entry is a pointer to
+// the row's four fields, stored back to back in a TextArena, and their
+// lengths.
+class TransactionTextStore {
+private:
+    struct ArenaText {
+        const char* base;
+        uint32_t lengths[4];
+    };
+
+    TextStorage storage;
+    TransactionText* strings;
+    ArenaText* spans;
+    TextArena arena;
+    uint32_t size;
+    uint32_t capacity;
+    void reallocate(uint32_t newCapacity);
+    void allocateEntries(uint32_t count);
+    void copyFrom(const TransactionTextStore& other);
+
+public:
+    explicit TransactionTextStore(uint32_t initialCapacity = 10, TextStorage storage = TextStorage::ARENA);
+    ~TransactionTextStore();
+    TransactionTextStore(const TransactionTextStore& other);
+    TransactionTextStore& operator=(const TransactionTextStore& other);
+    TransactionTextStore(TransactionTextStore&& other) noexcept;
+    TransactionTextStore& operator=(TransactionTextStore&& other) noexcept;
+
+    // Returns the index of the new entry. The rvalue overload moves the
+    // strings in when storing strings.
+    uint32_t add(const TransactionTextView& text);
+    uint32_t add(TransactionText&& text);
+    // Appends every entry of other, leaving it empty, and returns the index
+    // the first one now has. With the same storage nothing is copied: the
+    // arena blocks or strings change owner.
+    uint32_t adopt(TransactionTextStore& other);
+    uint32_t getSize() const { return size; }
+    TextStorage getStorage() const { return storage; }
+    // Room for at least minimumCapacity entries; never shrinks.
+    void reserve(uint32_t minimumCapacity);
+    void shrinkToFit();
+
+    TransactionTextView operator[](uint32_t row) const {
+        if (storage == TextStorage::STRINGS) {
+            return TransactionTextView(strings[row]);
+        }
+        const ArenaText& span = spans[row];
+        TransactionTextView view;
+        const char* p = span.base;
+        view.transaction_id = std::string_view(p, span.lengths[0]);
+        p += span.lengths[0];
+        view.sender_account = std::string_view(p, span.lengths[1]);
+        p += span.lengths[1];
+        view.receiver_account = std::string_view(p, span.lengths[2]);
+        p += span.lengths[2];
+        view.device_hash = std::string_view(p, span.lengths[3]);
+        return view;
+    }
+
+    // The per-row entries plus the strings' heap buffers or the arena
+    // blocks.
+    std::size_t getMemoryBytes() const;
+};
+
+// Rows are added together with their text, which goes into the container's
+// own TransactionTextStore; getText() finds it again for a row of this
+// container.
+//
+// The records live in uninitialized storage: a slot is only written when a
+// row is added to it, so a large reserve() costs address space rather than
+// a pass over every slot, and growing copies the live records with one
+// memcpy.
 class TransactionArray {
 private:
     Transaction* data;
     int size;
     int capacity;
+    TransactionTextStore texts;
     void expandCapacity();
+    void reallocate(int newCapacity);
 
 public:
-    TransactionArray(int initialCapacity = 10);
+    TransactionArray(int initialCapacity = 10, TextStorage textStorage = TextStorage::ARENA);
     ~TransactionArray();
     TransactionArray(const TransactionArray& other);
     TransactionArray& operator=(const TransactionArray& other);
     TransactionArray(TransactionArray&& other) noexcept;
     TransactionArray& operator=(TransactionArray&& other) noexcept;
 
-    void addTransaction(const Transaction& tx);
+    void addTransaction(const Transaction& tx, const TransactionTextView& text);
+    void addTransaction(Transaction&& tx, TransactionText&& text);
+    // Appends the first count rows of rows together with its whole text
+    // store (see TransactionTextStore::adopt); rows is left empty.
+    void adoptRows(TransactionArray& rows, int count);
     int getSize() const;
+    int getCapacity() const { return capacity; }
+    // Room for at least minimumCapacity rows and their text entries, so
+    // that many adds never reallocate; never shrinks.
+    void reserve(int minimumCapacity);
+    // Releases the slots past getSize().
+    void shrinkToFit();
 
     Transaction* getTransaction(int index);
     const Transaction* getTransaction(int index) const;
 
+    TransactionTextView getText(const Transaction& tx) const { return texts[tx.textRow]; }
+    TextStorage getTextStorage() const { return texts.getStorage(); }
+    std::size_t getTextMemoryBytes() const { return texts.getMemoryBytes(); }
+
     Transaction* getDataPointer();
     const Transaction* getDataPointer() const;
+
+    Transaction* begin() { return data; }
+    Transaction* end() { return data + size; }
+    const Transaction* begin() const { return data; }
+    const Transaction* end() const { return data + size; }
+};
+
+// Forward iterator over a TransactionArrayView: a position in its list of
+// row indices, dereferenced through the array's records.
+class TransactionIndexIterator {
+private:
+    const Transaction* records;
+    const int* position;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Transaction;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Transaction*;
+    using reference = const Transaction&;
+
+    TransactionIndexIterator(const Transaction* records = nullptr, const int* position = nullptr)
+        : records(records), position(position) {}
+    const Transaction& operator*() const { return records[*position]; }
+    const Transaction* operator->() const { return records + *position; }
+    TransactionIndexIterator& operator++() { ++position; return *this; }
+    TransactionIndexIterator operator++(int) { TransactionIndexIterator before = *this; ++position; return before; }
+    bool operator==(const TransactionIndexIterator& other) const { return position == other.position; }
+    bool operator!=(const TransactionIndexIterator& other) const { return position != other.position; }
+};
+
+// The rows of a TransactionArray in an order of their own, held as a list
+// of row indices so that no record moves. It reads like the containers
+// (getTransaction(), getText(), begin()/end()) and is only valid while the
+// array is left unchanged. A default-constructed view is inactive.
+class TransactionArrayView {
+private:
+    const TransactionArray* array;
+    int* rows;
+    int size;
+
+public:
+    TransactionArrayView();
+    // Takes ownership of rows: a new[] array holding each of the array's
+    // getSize() row indices once.
+    TransactionArrayView(const TransactionArray& array, int* rows);
+    ~TransactionArrayView();
+    TransactionArrayView(const TransactionArrayView&) = delete;
+    TransactionArrayView& operator=(const TransactionArrayView&) = delete;
+    TransactionArrayView(TransactionArrayView&& other) noexcept;
+    TransactionArrayView& operator=(TransactionArrayView&& other) noexcept;
+
+    bool isActive() const { return array != nullptr; }
+    int getSize() const { return size; }
+    const int* getRows() const { return rows; }
+
+    const Transaction* getTransaction(int index) const { return array->getDataPointer() + rows[index]; }
+    TransactionTextView getText(const Transaction& tx) const { return array->getText(tx); }
+    TextStorage getTextStorage() const { return array->getTextStorage(); }
+
+    using const_iterator = TransactionIndexIterator;
+    const_iterator begin() const { return const_iterator(array ? array->getDataPointer() : nullptr, rows); }
+    const_iterator end() const { return const_iterator(array ? array->getDataPointer() : nullptr, rows + size); }
 };
 
 struct TransactionNode {
@@ -36,28 +228,215 @@ struct TransactionNode {
     TransactionNode(Transaction&& t) noexcept : data(std::move(t)), next(nullptr) {}
 };
 
+// Forward iterator over the records of a TransactionLinkedList. Stepping
+// follows one next pointer, where getTransaction(i) walks i nodes from head.
+template <typename Record>
+class TransactionListIterator {
+private:
+    TransactionNode* node;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Transaction;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Record*;
+    using reference = Record&;
+
+    explicit TransactionListIterator(TransactionNode* start = nullptr) : node(start) {}
+    Record& operator*() const { return node->data; }
+    Record* operator->() const { return &node->data; }
+    TransactionListIterator& operator++() { node = node->next; return *this; }
+    TransactionListIterator operator++(int) { TransactionListIterator before = *this; node = node->next; return before; }
+    bool operator==(const TransactionListIterator& other) const { return node == other.node; }
+    bool operator!=(const TransactionListIterator& other) const { return node != other.node; }
+};
+
+// How a TransactionLinkedList gets memory for its nodes.
+enum class NodeAllocation {
+    HEAP,  // one new and one delete per node
+    POOL   // nodes carved out of large slabs by a TransactionNodePool
+};
+
+// Slab allocator for list nodes. Nodes are handed out from contiguous slabs
+// of NODES_PER_SLAB, so neighbours in the list are usually neighbours in
+// memory. Nodes are never freed one at a time: destroying or resetting the
+// pool drops every node at once, one delete per slab.
+class TransactionNodePool {
+private:
+    static const int NODES_PER_SLAB = 4096;
+
+    TransactionNode** slabs;
+    int slabCount;
+    int slabCapacity;
+    // Slabs before activeSlab are full; nodes [0, usedInSlab) of activeSlab
+    // have been handed out.
+    int activeSlab;
+    int usedInSlab;
+    void release();
+
+public:
+    TransactionNodePool();
+    ~TransactionNodePool();
+    TransactionNodePool(const TransactionNodePool&) = delete;
+    TransactionNodePool& operator=(const TransactionNodePool&) = delete;
+    TransactionNodePool(TransactionNodePool&& other) noexcept;
+    TransactionNodePool& operator=(TransactionNodePool&& other) noexcept;
+
+    TransactionNode* allocate(const Transaction& tx);
+    // Forgets every node but keeps the slabs for the next allocations.
+    void reset();
+    std::size_t getReservedBytes() const;
+};
+
 class TransactionLinkedList {
 private:
     TransactionNode* head;
     TransactionNode* tail;
     int size;
+    NodeAllocation allocation;
+    TransactionNodePool pool;
+    TransactionTextStore texts;
+    TransactionNode* createNode(const Transaction& tx);
+    // Frees every node and leaves the list empty; pooled slabs are kept.
+    void releaseNodes();
+    void copyNodesFrom(const TransactionLinkedList& other);
 
 public:
-    TransactionLinkedList();
+    explicit TransactionLinkedList(TextStorage textStorage = TextStorage::ARENA,
+                                   NodeAllocation nodeAllocation = NodeAllocation::POOL);
     ~TransactionLinkedList();
     TransactionLinkedList(const TransactionLinkedList& other);
     TransactionLinkedList& operator=(const TransactionLinkedList& other);
     TransactionLinkedList(TransactionLinkedList&& other) noexcept;
     TransactionLinkedList& operator=(TransactionLinkedList&& other) noexcept;
 
-    void addTransaction(const Transaction& tx);
+    void addTransaction(const Transaction& tx, const TransactionTextView& text);
+    void addTransaction(Transaction&& tx, TransactionText&& text);
+    // Links a new node in after position (at the front if position is
+    // nullptr) and returns it.
+    TransactionNode* insertAfter(TransactionNode* position, const Transaction& tx, const TransactionTextView& text);
+    // Links the list's own nodes in the order of nodes[0, getSize()), which
+    // must hold each of them once. No node is copied or reallocated.
+    void relink(TransactionNode* const* nodes);
+    // Takes a chain of the list's own nodes, such as the head a list merge
+    // sort returns, as the whole list: head, tail and size are set from it.
+    void adoptSortedChain(TransactionNode* newHead);
     int getSize() const;
 
     TransactionNode* getHead() const { return head; };
-    void setHead(TransactionNode* newHead) { head = newHead; };
 
     Transaction* getTransaction(int index);
     const Transaction* getTransaction(int index) const;
+
+    TransactionTextView getText(const Transaction& tx) const { return texts[tx.textRow]; }
+    TextStorage getTextStorage() const { return texts.getStorage(); }
+    std::size_t getTextMemoryBytes() const { return texts.getMemoryBytes(); }
+    NodeAllocation getNodeAllocation() const { return allocation; }
+
+    using iterator = TransactionListIterator<Transaction>;
+    using const_iterator = TransactionListIterator<const Transaction>;
+    iterator begin() { return iterator(head); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(); }
+};
+
+// A node of a TransactionUnrolledList: up to ROWS_PER_BLOCK records stored
+// side by side, rows[0, count) in list order.
+struct TransactionBlock {
+    static const int ROWS_PER_BLOCK = 32;
+
+    Transaction rows[ROWS_PER_BLOCK];
+    int count;
+    TransactionBlock* next;
+
+    TransactionBlock() : count(0), next(nullptr) {}
+};
+
+// Forward iterator over the records of a TransactionUnrolledList: a block
+// and a slot in it. Blocks are never empty, so end is (nullptr, 0).
+template <typename Record>
+class TransactionBlockIterator {
+private:
+    TransactionBlock* block;
+    int slot;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Transaction;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Record*;
+    using reference = Record&;
+
+    explicit TransactionBlockIterator(TransactionBlock* start = nullptr) : block(start), slot(0) {}
+    Record& operator*() const { return block->rows[slot]; }
+    Record* operator->() const { return &block->rows[slot]; }
+    TransactionBlockIterator& operator++() {
+        if (++slot == block->count) {
+            block = block->next;
+            slot = 0;
+        }
+        return *this;
+    }
+    TransactionBlockIterator operator++(int) { TransactionBlockIterator before = *this; ++*this; return before; }
+    bool operator==(const TransactionBlockIterator& other) const { return block == other.block && slot == other.slot; }
+    bool operator!=(const TransactionBlockIterator& other) const { return !(*this == other); }
+};
+
+// A singly linked list whose nodes each hold a block of rows, so a walk
+// over it follows one pointer per ROWS_PER_BLOCK rows and reads the rows of
+// a block contiguously. Appends fill the tail block; an insert into a full
+// block splits it in two, and a block left less than half full by a remove
+// takes rows from the next one or is merged into it.
+class TransactionUnrolledList {
+private:
+    TransactionBlock* head;
+    TransactionBlock* tail;
+    int size;
+    int blockCount;
+    TransactionTextStore texts;
+    void releaseBlocks();
+    void copyBlocksFrom(const TransactionUnrolledList& other);
+    // Finds the block holding row index; slot is its position in the block.
+    TransactionBlock* locate(int index, int& slot) const;
+    void appendRecord(const Transaction& tx);
+
+public:
+    explicit TransactionUnrolledList(TextStorage textStorage = TextStorage::ARENA);
+    ~TransactionUnrolledList();
+    TransactionUnrolledList(const TransactionUnrolledList& other);
+    TransactionUnrolledList& operator=(const TransactionUnrolledList& other);
+    TransactionUnrolledList(TransactionUnrolledList&& other) noexcept;
+    TransactionUnrolledList& operator=(TransactionUnrolledList&& other) noexcept;
+
+    void addTransaction(const Transaction& tx, const TransactionTextView& text);
+    void addTransaction(Transaction&& tx, TransactionText&& text);
+    // Inserts the row at slot of block (appends it if block is nullptr) and
+    // returns the block and slot it ended up at, which differ from the
+    // arguments when the block was split.
+    TransactionBlock* insertAt(TransactionBlock* block, int slot, const Transaction& tx,
+                               const TransactionTextView& text, int& insertedSlot);
+    // Removes row index. Its text stays in the text store, as the store is
+    // append-only.
+    void removeAt(int index);
+    int getSize() const { return size; }
+    int getBlockCount() const { return blockCount; }
+
+    TransactionBlock* getHead() const { return head; }
+
+    Transaction* getTransaction(int index);
+    const Transaction* getTransaction(int index) const;
+
+    TransactionTextView getText(const Transaction& tx) const { return texts[tx.textRow]; }
+    TextStorage getTextStorage() const { return texts.getStorage(); }
+    std::size_t getTextMemoryBytes() const { return texts.getMemoryBytes(); }
+
+    using iterator = TransactionBlockIterator<Transaction>;
+    using const_iterator = TransactionBlockIterator<const Transaction>;
+    iterator begin() { return iterator(head); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(); }
 };
 
 #endif
\ No newline at end of file
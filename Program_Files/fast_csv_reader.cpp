@@ -0,0 +1,579 @@
+#include "fast_csv_reader.h"
+#include "transaction_fields.h"
+#include <iostream>
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <glob.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+
+const char* const CSV_COLUMN_NAMES[CSV_COLUMN_COUNT] = {
+    "transaction_id", "timestamp", "sender_account", "receiver_account",
+    "amount", "transaction_type", "merchant_category", "location",
+    "device_used", "is_fraud", "fraud_type", "time_since_last_transaction",
+    "spending_deviation_score", "velocity_score", "geo_anomaly_score",
+    "payment_channel", "ip_address", "device_hash"
+};
+
+bool parseCsvColumnList(const std::string& list, CsvColumnSet& columns) {
+    CsvColumnSet result = 0;
+    std::size_t start = 0;
+    while (start <= list.size()) {
+        std::size_t comma = list.find(',', start);
+        if (comma == std::string::npos) comma = list.size();
+        std::string name = list.substr(start, comma - start);
+        if (!name.empty()) {
+            int column = -1;
+            for (int c = 0; c < CSV_COLUMN_COUNT; ++c) {
+                if (name == CSV_COLUMN_NAMES[c]) {
+                    column = c;
+                    break;
+                }
+            }
+            if (column < 0) {
+                std::cerr << "Unknown column '" << name << "'. Known columns: "
+                          << csvColumnListToString(ALL_CSV_COLUMNS) << "\n";
+                return false;
+            }
+            result |= csvColumnBit(static_cast<CsvColumn>(column));
+        }
+        start = comma + 1;
+    }
+    if (result == 0) {
+        std::cerr << "No columns given.\n";
+        return false;
+    }
+    columns = result;
+    return true;
+}
+
+std::string csvColumnListToString(CsvColumnSet columns) {
+    std::string list;
+    for (int c = 0; c < CSV_COLUMN_COUNT; ++c) {
+        if (columns & csvColumnBit(static_cast<CsvColumn>(c))) {
+            if (!list.empty()) list += ',';
+            list += CSV_COLUMN_NAMES[c];
+        }
+    }
+    return list;
+}
+
+static const char* findCsvDelimiterScalar(const char* p, const char* end) {
+    while (p < end && *p != ',' && *p != '\n') ++p;
+    return p;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FAST_CSV_HAVE_X86_KERNELS 1
+
+__attribute__((target("sse2")))
+static const char* findCsvDelimiterSse2(const char* p, const char* end) {
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, comma), _mm_cmpeq_epi8(block, newline)));
+        if (mask != 0) return p + __builtin_ctz(static_cast<unsigned int>(mask));
+        p += 16;
+    }
+    return findCsvDelimiterScalar(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* findCsvDelimiterAvx2(const char* p, const char* end) {
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    while (end - p >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, comma), _mm256_cmpeq_epi8(block, newline))));
+        if (mask != 0) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return findCsvDelimiterSse2(p, end);
+}
+#endif
+
+bool csvScanKernelSupported(CsvScanKernel kernel) {
+    switch (kernel) {
+        case CsvScanKernel::SCALAR: return true;
+#ifdef FAST_CSV_HAVE_X86_KERNELS
+        case CsvScanKernel::SSE2: return __builtin_cpu_supports("sse2");
+        case CsvScanKernel::AVX2: return __builtin_cpu_supports("avx2");
+#endif
+        default: return false;
+    }
+}
+
+const char* csvScanKernelName(CsvScanKernel kernel) {
+    switch (kernel) {
+        case CsvScanKernel::SCALAR: return "Scalar";
+        case CsvScanKernel::SSE2: return "SSE2 (16 B)";
+        case CsvScanKernel::AVX2: return "AVX2 (32 B)";
+        default: return "Unknown";
+    }
+}
+
+static CsvScanKernel detectCsvScanKernel() {
+    if (csvScanKernelSupported(CsvScanKernel::AVX2)) return CsvScanKernel::AVX2;
+    if (csvScanKernelSupported(CsvScanKernel::SSE2)) return CsvScanKernel::SSE2;
+    return CsvScanKernel::SCALAR;
+}
+
+static const CsvScanKernel ACTIVE_SCAN_KERNEL = detectCsvScanKernel();
+
+CsvScanKernel activeCsvScanKernel() {
+    return ACTIVE_SCAN_KERNEL;
+}
+
+const char* findCsvDelimiterWith(CsvScanKernel kernel, const char* p, const char* end) {
+    switch (kernel) {
+#ifdef FAST_CSV_HAVE_X86_KERNELS
+        case CsvScanKernel::AVX2: return findCsvDelimiterAvx2(p, end);
+        case CsvScanKernel::SSE2: return findCsvDelimiterSse2(p, end);
+#endif
+        default: return findCsvDelimiterScalar(p, end);
+    }
+}
+
+const char* findCsvDelimiter(const char* p, const char* end) {
+    return findCsvDelimiterWith(ACTIVE_SCAN_KERNEL, p, end);
+}
+
+static void trimSpaces(const char*& begin, const char*& end) {
+    while (begin < end && *begin == ' ') ++begin;
+    while (end > begin && end[-1] == ' ') --end;
+}
+
+MappedCsvFile::MappedCsvFile() : mapped(nullptr), length(0), fd(-1) {}
+
+MappedCsvFile::~MappedCsvFile() {
+    close();
+}
+
+bool isMultiFileSource(const std::string& source) {
+    struct stat st;
+    if (stat(source.c_str(), &st) == 0) {
+        return S_ISDIR(st.st_mode);
+    }
+    return source.find_first_of("*?[") != std::string::npos;
+}
+
+int expandCsvSources(const std::string& source, std::string*& paths) {
+    if (!isMultiFileSource(source)) {
+        paths = new std::string[1];
+        paths[0] = source;
+        return 1;
+    }
+
+    struct stat st;
+    std::string pattern = source;
+    if (stat(source.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        pattern = source + (source.back() == '/' ? "*.csv" : "/*.csv");
+    }
+    glob_t matches;
+    int count = 0;
+    if (glob(pattern.c_str(), 0, nullptr, &matches) == 0) {
+        paths = new std::string[matches.gl_pathc];
+        for (std::size_t i = 0; i < matches.gl_pathc; ++i) {
+            if (stat(matches.gl_pathv[i], &st) == 0 && S_ISREG(st.st_mode)) {
+                paths[count++] = matches.gl_pathv[i];
+            }
+        }
+        globfree(&matches);
+    } else {
+        paths = new std::string[1];
+    }
+    return count;
+}
+
+bool MappedCsvFile::open(const std::string& filePath) {
+    close();
+
+    fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::perror(("Error opening " + filePath).c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        std::perror(("Error reading size of " + filePath).c_str());
+        close();
+        return false;
+    }
+    length = static_cast<std::size_t>(st.st_size);
+    if (length == 0) {
+        return true;
+    }
+
+    void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+        std::perror(("Error mapping " + filePath).c_str());
+        length = 0;
+        close();
+        return false;
+    }
+    madvise(p, length, MADV_SEQUENTIAL);
+    mapped = static_cast<const char*>(p);
+    return true;
+}
+
+void MappedCsvFile::close() {
+    if (mapped != nullptr) {
+        munmap(const_cast<char*>(mapped), length);
+        mapped = nullptr;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    length = 0;
+}
+
+int estimateCsvRowCount(const char* begin, const char* end) {
+    const std::size_t bytes = static_cast<std::size_t>(end - begin);
+    const std::size_t sampled = bytes < 64 * 1024 ? bytes : 64 * 1024;
+    std::size_t lines = 0;
+    for (const char* p = begin; (p = static_cast<const char*>(std::memchr(p, '\n', begin + sampled - p))) != nullptr; ++p) {
+        lines++;
+    }
+    if (lines == 0) {
+        return 16;
+    }
+    double rows = static_cast<double>(bytes) / sampled * lines;
+    return static_cast<int>(rows * 1.02) + 16;
+}
+
+const char* lastCompleteLineEnd(const char* begin, const char* end) {
+    while (end > begin && end[-1] != '\n') {
+        --end;
+    }
+    return end;
+}
+
+void releaseMappedRange(const char* begin, const char* end) {
+    const std::uintptr_t page = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    std::uintptr_t first = (reinterpret_cast<std::uintptr_t>(begin) + page - 1) & ~(page - 1);
+    std::uintptr_t last = reinterpret_cast<std::uintptr_t>(end) & ~(page - 1);
+    if (first < last) {
+        madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+    }
+}
+
+CsvColumnLayout::CsvColumnLayout() : columnCount(0) {
+    for (int i = 0; i < MAX_COLUMNS; ++i) columnFor[i] = -1;
+}
+
+bool CsvColumnLayout::parseHeader(const char*& cursor, const char* end) {
+    const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+    if (lineEnd == nullptr) lineEnd = end;
+    const char* headerEnd = lineEnd;
+    if (headerEnd > cursor && headerEnd[-1] == '\r') --headerEnd;
+
+    bool found[CSV_COLUMN_COUNT] = {};
+    columnCount = 0;
+    const char* p = cursor;
+    while (true) {
+        const char* sep = static_cast<const char*>(std::memchr(p, ',', headerEnd - p));
+        if (sep == nullptr) sep = headerEnd;
+        const char* nameBegin = p;
+        const char* nameEnd = sep;
+        trimSpaces(nameBegin, nameEnd);
+        if (nameEnd - nameBegin >= 2 && *nameBegin == '"' && nameEnd[-1] == '"') {
+            ++nameBegin;
+            --nameEnd;
+        }
+        std::string name(nameBegin, nameEnd);
+
+        int column = -1;
+        for (int c = 0; c < CSV_COLUMN_COUNT; ++c) {
+            if (name == CSV_COLUMN_NAMES[c]) {
+                column = c;
+                break;
+            }
+        }
+        if (column < 0) {
+            std::cerr << "Error: Extra column \"" << name << "\" in CSV header\n";
+            return false;
+        }
+        if (found[column]) {
+            std::cerr << "Error: Duplicated column \"" << name << "\" in CSV header\n";
+            return false;
+        }
+        if (columnCount == MAX_COLUMNS) {
+            std::cerr << "Error: Too many columns in CSV header\n";
+            return false;
+        }
+        found[column] = true;
+        columnFor[columnCount++] = column;
+
+        if (sep == headerEnd) break;
+        p = sep + 1;
+    }
+
+    for (int c = 0; c < CSV_COLUMN_COUNT; ++c) {
+        if (!found[c]) {
+            std::cerr << "Error: Missing column \"" << CSV_COLUMN_NAMES[c] << "\" in CSV header\n";
+            return false;
+        }
+    }
+
+    cursor = lineEnd < end ? lineEnd + 1 : end;
+    return true;
+}
+
+MappedCsvReader::MappedCsvReader(const char* begin, const char* end, const CsvColumnLayout& layout, long firstLineNumber,
+                                 CsvQuoting quoting)
+    : cursor(begin), rowStart(begin), limit(end), layout(layout), lineNumber(firstLineNumber - 1),
+      nextLineNumber(firstLineNumber), unescaped(nullptr), unescapedCapacity(0) {
+    // The parallel parser gives each chunk its own reader, so a quoted
+    // field only moves its own chunk off the plain delimiter scan.
+    quoted = quoting == CsvQuoting::RFC4180 ||
+             (quoting == CsvQuoting::DETECT && begin < end && std::memchr(begin, '"', end - begin) != nullptr);
+}
+
+MappedCsvReader::~MappedCsvReader() {
+    delete[] unescaped;
+}
+
+bool MappedCsvReader::readRow(CsvField (&fields)[CSV_COLUMN_COUNT]) {
+    if (quoted) {
+        return readQuotedRow(fields);
+    }
+    while (cursor < limit) {
+        lineNumber = nextLineNumber++;
+        rowStart = cursor;
+
+        // One pass per field: the scanner stops at whichever of ',' or '\n'
+        // comes first, so the row is never walked twice.
+        int column = 0;
+        const char* p = cursor;
+        const char* sep;
+        while (true) {
+            sep = findCsvDelimiter(p, limit);
+            const bool lastField = (sep == limit || *sep == '\n');
+            const char* fieldBegin = p;
+            const char* fieldEnd = sep;
+            if (lastField && fieldEnd > fieldBegin && fieldEnd[-1] == '\r') --fieldEnd;
+            if (column < layout.getColumnCount()) {
+                trimSpaces(fieldBegin, fieldEnd);
+                CsvField& field = fields[layout.getColumn(column)];
+                field.data = fieldBegin;
+                field.length = static_cast<std::size_t>(fieldEnd - fieldBegin);
+            }
+            ++column;
+            if (lastField) break;
+            p = sep + 1;
+        }
+
+        const char* next = sep < limit ? sep + 1 : limit;
+        const bool emptyLine = column == 1 && (sep == cursor || (sep == cursor + 1 && *cursor == '\r'));
+        cursor = next;
+        if (emptyLine) {
+            continue;
+        }
+        if (column != layout.getColumnCount()) {
+            throw ParseError(ParseErrorKind::ROW_SHAPE, "expected " + std::to_string(layout.getColumnCount())
+                             + " columns, found " + std::to_string(column));
+        }
+        return true;
+    }
+    return false;
+}
+
+// Moves the cursor past the rest of the physical line at p, so a row with
+// broken quoting is skipped without its quotes swallowing the rows after it.
+static const char* skipLine(const char* p, const char* end) {
+    const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    return nl ? nl + 1 : end;
+}
+
+bool MappedCsvReader::readQuotedRow(CsvField (&fields)[CSV_COLUMN_COUNT]) {
+    while (cursor < limit) {
+        lineNumber = nextLineNumber++;
+        rowStart = cursor;
+
+        // Fields with "" are unescaped into the buffer as they are found but
+        // only pointed at once the row is complete, since it may grow.
+        std::size_t escapedOffset[CSV_COLUMN_COUNT];
+        bool escaped[CSV_COLUMN_COUNT] = {};
+        std::size_t used = 0;
+        int column = 0;
+        const char* p = cursor;
+        const char* sep;
+        while (true) {
+            const char* fieldBegin = p;
+            const char* fieldEnd;
+            bool hasEscapes = false;
+            while (fieldBegin < limit && *fieldBegin == ' ') ++fieldBegin;
+            if (fieldBegin < limit && *fieldBegin == '"') {
+                ++fieldBegin;
+                const char* close = fieldBegin;
+                while (true) {
+                    close = static_cast<const char*>(std::memchr(close, '"', limit - close));
+                    if (close == nullptr) {
+                        cursor = skipLine(rowStart, limit);
+                        throw ParseError(ParseErrorKind::QUOTING, "unterminated quoted field in column "
+                                         + std::to_string(column + 1));
+                    }
+                    if (close + 1 < limit && close[1] == '"') {
+                        hasEscapes = true;
+                        close += 2;
+                        continue;
+                    }
+                    break;
+                }
+                fieldEnd = close;
+                for (const char* c = fieldBegin; c < fieldEnd; ++c) {
+                    if (*c == '\n') ++nextLineNumber;
+                }
+                sep = close + 1;
+                while (sep < limit && *sep == ' ') ++sep;
+                if (sep < limit && *sep == '\r' && (sep + 1 == limit || sep[1] == '\n')) ++sep;
+                if (sep < limit && *sep != ',' && *sep != '\n') {
+                    cursor = skipLine(sep, limit);
+                    throw ParseError(ParseErrorKind::QUOTING, "unexpected text after the closing quote in column "
+                                     + std::to_string(column + 1));
+                }
+            } else {
+                fieldBegin = p;
+                sep = findCsvDelimiter(p, limit);
+                fieldEnd = sep;
+                if ((sep == limit || *sep == '\n') && fieldEnd > fieldBegin && fieldEnd[-1] == '\r') --fieldEnd;
+                trimSpaces(fieldBegin, fieldEnd);
+            }
+            const bool lastField = (sep == limit || *sep == '\n');
+
+            if (column < layout.getColumnCount()) {
+                const int target = layout.getColumn(column);
+                CsvField& field = fields[target];
+                if (hasEscapes) {
+                    const std::size_t need = used + static_cast<std::size_t>(fieldEnd - fieldBegin);
+                    if (need > unescapedCapacity) {
+                        std::size_t capacity = unescapedCapacity * 2 > need ? unescapedCapacity * 2 : need + 256;
+                        char* grown = new char[capacity];
+                        if (used > 0) std::memcpy(grown, unescaped, used);
+                        delete[] unescaped;
+                        unescaped = grown;
+                        unescapedCapacity = capacity;
+                    }
+                    escapedOffset[target] = used;
+                    escaped[target] = true;
+                    for (const char* c = fieldBegin; c < fieldEnd; ++c) {
+                        unescaped[used++] = *c;
+                        if (*c == '"') ++c;
+                    }
+                    field.length = used - escapedOffset[target];
+                } else {
+                    field.data = fieldBegin;
+                    field.length = static_cast<std::size_t>(fieldEnd - fieldBegin);
+                }
+            }
+            ++column;
+            if (lastField) break;
+            p = sep + 1;
+        }
+
+        const char* next = sep < limit ? sep + 1 : limit;
+        const bool emptyLine = column == 1 && (sep == cursor || (sep == cursor + 1 && *cursor == '\r'));
+        cursor = next;
+        if (emptyLine) {
+            continue;
+        }
+        if (column != layout.getColumnCount()) {
+            throw ParseError(ParseErrorKind::ROW_SHAPE, "expected " + std::to_string(layout.getColumnCount())
+                             + " columns, found " + std::to_string(column));
+        }
+        for (int c = 0; c < CSV_COLUMN_COUNT; ++c) {
+            if (escaped[c]) fields[c].data = unescaped + escapedOffset[c];
+        }
+        return true;
+    }
+    return false;
+}
+
+CsvField MappedCsvReader::getRowText() const {
+    const char* end = cursor;
+    if (end > rowStart && end[-1] == '\n') --end;
+    if (end > rowStart && end[-1] == '\r') --end;
+    CsvField text = {rowStart, static_cast<std::size_t>(end - rowStart)};
+    return text;
+}
+
+static double fieldToDouble(const CsvField& field) {
+    return parseRequiredDouble(field.data, field.length);
+}
+
+static bool fieldEquals(const CsvField& field, const char* literal) {
+    std::size_t n = std::strlen(literal);
+    return field.length == n && std::memcmp(field.data, literal, n) == 0;
+}
+
+static std::string_view fieldView(const CsvField& field) {
+    return std::string_view(field.data, field.length);
+}
+
+void fillTransactionFromFields(const CsvField (&fields)[CSV_COLUMN_COUNT], Transaction& tx, TransactionText& text,
+                               CsvColumnSet columns) {
+    TransactionTextView slices;
+    fillTransactionFromFields(fields, tx, slices, columns);
+    auto wanted = [columns](CsvColumn column) { return (columns & csvColumnBit(column)) != 0; };
+    if (wanted(CSV_TRANSACTION_ID)) text.transaction_id.assign(slices.transaction_id);
+    if (wanted(CSV_SENDER_ACCOUNT)) text.sender_account.assign(slices.sender_account);
+    if (wanted(CSV_RECEIVER_ACCOUNT)) text.receiver_account.assign(slices.receiver_account);
+    if (wanted(CSV_DEVICE_HASH)) text.device_hash.assign(slices.device_hash);
+}
+
+void fillTransactionFromFields(const CsvField (&fields)[CSV_COLUMN_COUNT], Transaction& tx, TransactionTextView& text,
+                               CsvColumnSet columns) {
+    auto wanted = [columns](CsvColumn column) { return (columns & csvColumnBit(column)) != 0; };
+    if (wanted(CSV_TRANSACTION_ID))
+        text.transaction_id = fieldView(fields[CSV_TRANSACTION_ID]);
+    if (wanted(CSV_TIMESTAMP))
+        tx.timestamp = parseTimestampMicros(fields[CSV_TIMESTAMP].data, fields[CSV_TIMESTAMP].length);
+    if (wanted(CSV_SENDER_ACCOUNT))
+        text.sender_account = fieldView(fields[CSV_SENDER_ACCOUNT]);
+    if (wanted(CSV_RECEIVER_ACCOUNT))
+        text.receiver_account = fieldView(fields[CSV_RECEIVER_ACCOUNT]);
+    if (wanted(CSV_AMOUNT))
+        tx.amount = fieldToDouble(fields[CSV_AMOUNT]);
+    if (wanted(CSV_TRANSACTION_TYPE))
+        tx.transaction_type = encodeCategory(CATEGORY_TRANSACTION_TYPE, fields[CSV_TRANSACTION_TYPE].data,
+                                             fields[CSV_TRANSACTION_TYPE].length);
+    if (wanted(CSV_MERCHANT_CATEGORY))
+        tx.merchant_category = encodeCategory(CATEGORY_MERCHANT_CATEGORY, fields[CSV_MERCHANT_CATEGORY].data,
+                                              fields[CSV_MERCHANT_CATEGORY].length);
+    if (wanted(CSV_LOCATION))
+        tx.location = encodeCategory(CATEGORY_LOCATION, fields[CSV_LOCATION].data, fields[CSV_LOCATION].length);
+    if (wanted(CSV_DEVICE_USED))
+        tx.device_used = encodeCategory(CATEGORY_DEVICE_USED, fields[CSV_DEVICE_USED].data,
+                                        fields[CSV_DEVICE_USED].length);
+    if (wanted(CSV_IS_FRAUD))
+        tx.is_fraud = fieldEquals(fields[CSV_IS_FRAUD], "True") || fieldEquals(fields[CSV_IS_FRAUD], "true");
+    if (wanted(CSV_FRAUD_TYPE))
+        tx.fraud_type = encodeCategory(CATEGORY_FRAUD_TYPE, fields[CSV_FRAUD_TYPE].data, fields[CSV_FRAUD_TYPE].length);
+    if (wanted(CSV_TIME_SINCE_LAST_TRANSACTION))
+        tx.time_since_last_transaction = parseNullableDouble(fields[CSV_TIME_SINCE_LAST_TRANSACTION].data,
+                                                             fields[CSV_TIME_SINCE_LAST_TRANSACTION].length);
+    if (wanted(CSV_SPENDING_DEVIATION_SCORE))
+        tx.spending_deviation_score = fieldToDouble(fields[CSV_SPENDING_DEVIATION_SCORE]);
+    if (wanted(CSV_VELOCITY_SCORE))
+        tx.velocity_score = fieldToDouble(fields[CSV_VELOCITY_SCORE]);
+    if (wanted(CSV_GEO_ANOMALY_SCORE))
+        tx.geo_anomaly_score = fieldToDouble(fields[CSV_GEO_ANOMALY_SCORE]);
+    if (wanted(CSV_PAYMENT_CHANNEL))
+        tx.payment_channel = encodeCategory(CATEGORY_PAYMENT_CHANNEL, fields[CSV_PAYMENT_CHANNEL].data,
+                                            fields[CSV_PAYMENT_CHANNEL].length);
+    if (wanted(CSV_IP_ADDRESS))
+        tx.ip_address = parseIPv4(fields[CSV_IP_ADDRESS].data, fields[CSV_IP_ADDRESS].length);
+    if (wanted(CSV_DEVICE_HASH))
+        text.device_hash = fieldView(fields[CSV_DEVICE_HASH]);
+}
@@ -0,0 +1,198 @@
+#ifndef FAST_CSV_READER_H
+#define FAST_CSV_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "transaction.h"
+
+// Column order used for the field slices handed out by MappedCsvReader,
+// independent of the order the columns appear in the CSV header.
+enum CsvColumn {
+    CSV_TRANSACTION_ID,
+    CSV_TIMESTAMP,
+    CSV_SENDER_ACCOUNT,
+    CSV_RECEIVER_ACCOUNT,
+    CSV_AMOUNT,
+    CSV_TRANSACTION_TYPE,
+    CSV_MERCHANT_CATEGORY,
+    CSV_LOCATION,
+    CSV_DEVICE_USED,
+    CSV_IS_FRAUD,
+    CSV_FRAUD_TYPE,
+    CSV_TIME_SINCE_LAST_TRANSACTION,
+    CSV_SPENDING_DEVIATION_SCORE,
+    CSV_VELOCITY_SCORE,
+    CSV_GEO_ANOMALY_SCORE,
+    CSV_PAYMENT_CHANNEL,
+    CSV_IP_ADDRESS,
+    CSV_DEVICE_HASH,
+    CSV_COLUMN_COUNT
+};
+
+extern const char* const CSV_COLUMN_NAMES[CSV_COLUMN_COUNT];
+
+// A set of columns, one bit per CsvColumn.
+typedef uint32_t CsvColumnSet;
+
+static const CsvColumnSet ALL_CSV_COLUMNS = (1u << CSV_COLUMN_COUNT) - 1;
+
+inline CsvColumnSet csvColumnBit(CsvColumn column) { return 1u << column; }
+
+// Parses a comma-separated list of header names ("transaction_id,amount").
+// Fails with a message on stderr for an empty list or an unknown name.
+bool parseCsvColumnList(const std::string& list, CsvColumnSet& columns);
+// Comma-separated names of the columns in the set, in CsvColumn order.
+std::string csvColumnListToString(CsvColumnSet columns);
+
+// A view into the mapped file. Not null-terminated.
+struct CsvField {
+    const char* data;
+    std::size_t length;
+};
+
+// Delimiter scanners used by MappedCsvReader. The widest one the CPU
+// supports is picked once at startup; the others stay callable so the
+// loader benchmark can compare them.
+enum class CsvScanKernel {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+bool csvScanKernelSupported(CsvScanKernel kernel);
+const char* csvScanKernelName(CsvScanKernel kernel);
+CsvScanKernel activeCsvScanKernel();
+
+// First ',' or '\n' in [p, end), or end if there is none.
+const char* findCsvDelimiter(const char* p, const char* end);
+const char* findCsvDelimiterWith(CsvScanKernel kernel, const char* p, const char* end);
+
+// Read-only memory mapping of a whole CSV file.
+class MappedCsvFile {
+private:
+    const char* mapped;
+    std::size_t length;
+    int fd;
+
+public:
+    MappedCsvFile();
+    ~MappedCsvFile();
+    MappedCsvFile(const MappedCsvFile&) = delete;
+    MappedCsvFile& operator=(const MappedCsvFile&) = delete;
+
+    bool open(const std::string& filePath);
+    void close();
+
+    bool isOpen() const { return fd >= 0; }
+    const char* begin() const { return mapped; }
+    const char* end() const { return mapped + length; }
+    std::size_t size() const { return length; }
+};
+
+// A directory (its *.csv files) or a glob pattern such as "data/2024-*.csv"
+// names several CSV files; anything else is a single file path.
+bool isMultiFileSource(const std::string& source);
+// Expands a source into file paths in name order, so hourly files load in
+// time order. Returns how many were found (0 if nothing matched); paths is
+// allocated with new[] and owned by the caller.
+int expandCsvSources(const std::string& source, std::string*& paths);
+
+// Rows in the CSV text [begin, end), for sizing a container before the
+// rows are parsed: the line length of the first 64 KB applied to the
+// whole range, plus a little slack. Quoted fields spanning lines only
+// make it larger.
+int estimateCsvRowCount(const char* begin, const char* end);
+
+// The end of the last complete line in [begin, end): just past its '\n', or
+// begin if there is none. A file still being appended to may end in a row
+// the writer has not finished; loading stops here and leaves it for later.
+const char* lastCompleteLineEnd(const char* begin, const char* end);
+
+// Drops the whole pages inside [begin, end) of a mapping from the resident
+// set once their rows have been copied out. The data stays readable.
+void releaseMappedRange(const char* begin, const char* end);
+
+// Maps the columns of a CSV header onto CsvColumn.
+class CsvColumnLayout {
+public:
+    static const int MAX_COLUMNS = 64;
+
+private:
+    int columnFor[MAX_COLUMNS];
+    int columnCount;
+
+public:
+    CsvColumnLayout();
+
+    // Consumes the header line at cursor. Fails (with a message on stderr) on
+    // missing, duplicated or unknown columns, like io::CSVReader does.
+    bool parseHeader(const char*& cursor, const char* end);
+
+    int getColumnCount() const { return columnCount; }
+    int getColumn(int csvIndex) const { return columnFor[csvIndex]; }
+};
+
+// How MappedCsvReader treats '"'. DETECT looks for a quote byte in its
+// range once, up front, and takes the plain delimiter scan when there is
+// none; the other two force one path (used by the loader benchmark).
+enum class CsvQuoting {
+    DETECT,
+    NONE,
+    RFC4180
+};
+
+// Splits rows of a mapped buffer into field slices without copying them.
+// With quoting, a field may be wrapped in double quotes and then hold
+// commas, newlines and "" for a literal quote; the slice covers the text
+// between the quotes, and only a field with "" is copied (unescaped) into
+// a buffer owned by the reader, valid until the next readRow(). A quote
+// inside an unquoted field is kept as text.
+// Throws ParseError (ROW_SHAPE or QUOTING) on a malformed row;
+// getLineNumber() and getRowText() then describe the offending row, and
+// the next readRow() carries on after it.
+class MappedCsvReader {
+private:
+    const char* cursor;
+    const char* rowStart;
+    const char* limit;
+    const CsvColumnLayout& layout;
+    long lineNumber;
+    long nextLineNumber;
+    bool quoted;
+    char* unescaped;
+    std::size_t unescapedCapacity;
+
+    bool readQuotedRow(CsvField (&fields)[CSV_COLUMN_COUNT]);
+
+public:
+    MappedCsvReader(const char* begin, const char* end, const CsvColumnLayout& layout, long firstLineNumber = 2,
+                    CsvQuoting quoting = CsvQuoting::DETECT);
+    ~MappedCsvReader();
+    MappedCsvReader(const MappedCsvReader&) = delete;
+    MappedCsvReader& operator=(const MappedCsvReader&) = delete;
+
+    bool readRow(CsvField (&fields)[CSV_COLUMN_COUNT]);
+
+    // The line the last row read starts on. A quoted field can span lines,
+    // so the next row starts on getNextLineNumber().
+    long getLineNumber() const { return lineNumber; }
+    long getNextLineNumber() const { return nextLineNumber; }
+    bool isQuoted() const { return quoted; }
+    const char* getPosition() const { return cursor; }
+    // The raw text of the row last read, without its line ending.
+    CsvField getRowText() const;
+};
+
+// Converts the requested columns of a row into its hot record and its text;
+// the others are neither parsed nor allocated and keep whatever tx and text
+// held (the defaults for new ones).
+void fillTransactionFromFields(const CsvField (&fields)[CSV_COLUMN_COUNT], Transaction& tx, TransactionText& text,
+                               CsvColumnSet columns = ALL_CSV_COLUMNS);
+// The same without copying the text: text gets slices of the fields, valid
+// as long as the bytes they point into (and, for a field with "", only
+// until the reader's next readRow()).
+void fillTransactionFromFields(const CsvField (&fields)[CSV_COLUMN_COUNT], Transaction& tx, TransactionTextView& text,
+                               CsvColumnSet columns = ALL_CSV_COLUMNS);
+
+#endif
@@ -5,6 +5,7 @@
 #include <thread>        
 #include <iomanip>
 #include <sstream>
+#include <cstdlib>
 #include "transaction_features.h"
 #include "transaction_manager.h"
 #include "csv_json_processing.h"
@@ -16,6 +17,8 @@ void showMenu() {
     std::cout << "2. Search Transactions by Type\n";
     std::cout << "3. Perform Full CSV to JSON Conversion (Bulk)\n";
     std::cout << "4. Switch Active Data Structure\n";
+    std::cout << "5. Compare CSV Loaders (Benchmark)\n";
+    std::cout << "6. Load New Rows Appended to the CSV\n";
     std::cout << "0. Exit\n";
     std::cout << "-----------------------------------------\n";
     std::cout << "Enter your choice: ";
@@ -32,19 +35,123 @@ int main(int argc, char* argv[]) {
     }
 
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <input_csv_file_path>\n";
+        std::cerr << "Usage: " << argv[0] << " <input_csv_file_path|directory|'glob'> [--csv-reader] [--threads=N]"
+                  << " [--file-threads=N] [--sort-threads=N] [--limit=N] [--columns=a,b,...] [--list-build=lazy|background|eager]"
+                  << " [--text-storage=arena|strings] [--array-sort=view|reorder]"
+                  << " [--follow=SECONDS] [--tolerant[=REJECT_FILE]] [--stream [--memory-budget-mb=N]]\n";
         return 1;
     }
     std::string initialCsvFile = argv[1];
+    bool useLegacyCsvReader = false;
+    int parseThreads = 1;
+    long rowLimit = 0;
+    bool streaming = false;
+    long memoryBudgetMB = 256;
+    CsvColumnSet columns = ALL_CSV_COLUMNS;
+    ListBuildMode listBuildMode = ListBuildMode::ON_FIRST_USE;
+    TextStorage textStorage = TextStorage::ARENA;
+    ArraySortMode arraySortMode = ArraySortMode::VIEW;
+    int followSeconds = 0;
+    int fileThreads = 0;
+    int sortThreads = 0;
+    bool tolerant = false;
+    std::string rejectPath = "results/rejected_rows.tsv";
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--csv-reader") {
+            useLegacyCsvReader = true;
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            parseThreads = std::atoi(arg.c_str() + 10);
+        } else if (arg.rfind("--limit=", 0) == 0) {
+            rowLimit = std::atol(arg.c_str() + 8);
+        } else if (arg.rfind("--columns=", 0) == 0) {
+            if (!parseCsvColumnList(arg.substr(10), columns)) {
+                return 1;
+            }
+        } else if (arg.rfind("--list-build=", 0) == 0) {
+            std::string mode = arg.substr(13);
+            if (mode == "lazy") {
+                listBuildMode = ListBuildMode::ON_FIRST_USE;
+            } else if (mode == "background") {
+                listBuildMode = ListBuildMode::BACKGROUND;
+            } else if (mode == "eager") {
+                listBuildMode = ListBuildMode::DURING_LOAD;
+            } else {
+                std::cerr << "Unknown --list-build mode: " << mode << " (expected lazy, background or eager)\n";
+                return 1;
+            }
+        } else if (arg.rfind("--text-storage=", 0) == 0) {
+            std::string mode = arg.substr(15);
+            if (mode == "arena") {
+                textStorage = TextStorage::ARENA;
+            } else if (mode == "strings") {
+                textStorage = TextStorage::STRINGS;
+            } else {
+                std::cerr << "Unknown --text-storage mode: " << mode << " (expected arena or strings)\n";
+                return 1;
+            }
+        } else if (arg.rfind("--array-sort=", 0) == 0) {
+            std::string mode = arg.substr(13);
+            if (mode == "view") {
+                arraySortMode = ArraySortMode::VIEW;
+            } else if (mode == "reorder") {
+                arraySortMode = ArraySortMode::REORDER;
+            } else {
+                std::cerr << "Unknown --array-sort mode: " << mode << " (expected view or reorder)\n";
+                return 1;
+            }
+        } else if (arg.rfind("--file-threads=", 0) == 0) {
+            fileThreads = std::atoi(arg.c_str() + 15);
+        } else if (arg.rfind("--sort-threads=", 0) == 0) {
+            sortThreads = std::atoi(arg.c_str() + 15);
+        } else if (arg.rfind("--follow=", 0) == 0) {
+            followSeconds = std::atoi(arg.c_str() + 9);
+        } else if (arg == "--tolerant") {
+            tolerant = true;
+        } else if (arg.rfind("--tolerant=", 0) == 0) {
+            tolerant = true;
+            rejectPath = arg.substr(11);
+        } else if (arg == "--stream") {
+            streaming = true;
+        } else if (arg.rfind("--memory-budget-mb=", 0) == 0) {
+            memoryBudgetMB = std::atol(arg.c_str() + 19);
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
     TransactionManager transactionManager;
+    transactionManager.setParseThreadCount(parseThreads);
+    transactionManager.setRowLimit(rowLimit);
+    transactionManager.setUseLegacyCsvReader(useLegacyCsvReader);
+    transactionManager.setListBuildMode(listBuildMode);
+    transactionManager.setArraySortMode(arraySortMode);
+    transactionManager.setTextStorage(textStorage);
+    transactionManager.setTailPollSeconds(followSeconds);
+    transactionManager.setFileLoadThreadCount(fileThreads);
+    transactionManager.setSortThreadCount(sortThreads);
+    CsvRejectLog rejectLog;
+    if (tolerant) {
+        if (!rejectLog.open(rejectPath)) {
+            return 1;
+        }
+        transactionManager.setRejectLog(&rejectLog);
+    }
 
-    if (!transactionManager.loadTransactionsFromCsv(initialCsvFile)) {
+    bool loaded;
+    if (streaming) {
+        loaded = transactionManager.enableStreamingMode(initialCsvFile, memoryBudgetMB);
+    } else {
+        loaded = transactionManager.loadTransactionsFromCsv(initialCsvFile, columns);
+    }
+    if (!loaded) {
         std::cerr << "Failed to load initial CSV data. Exiting.\n";
         return 1;
     }
 
     int choice;
     do {
+        transactionManager.pollForNewRows();
         showMenu();
         std::cin >> choice;
 
@@ -72,10 +179,12 @@ int main(int argc, char* argv[]) {
                 std::getline(std::cin, outputBulkJsonFile);
                 // Bulk conversion using threading
                 try {
-                    std::thread parser(parserWorker, initialCsvFile);
+                    std::thread parser(parserWorker, initialCsvFile, transactionManager.getParseThreadCount(),
+                                       useLegacyCsvReader, tolerant ? &rejectLog : nullptr);
                     std::thread writer(writerWorker, outputBulkJsonFile);
                     parser.join();
                     writer.join();
+                    if (tolerant) rejectLog.printSummary("Bulk conversion");
                     std::cout << "Bulk conversion completed.\n";
                 } catch (const std::exception& e) {
                     std::cerr << "Error during bulk conversion: " << e.what() << std::endl;
@@ -85,6 +194,14 @@ int main(int argc, char* argv[]) {
             case 4:
                 transactionManager.switchDataStructure();
                 break;
+            case 5:
+                transactionManager.compareCsvLoaders(initialCsvFile);
+                break;
+            case 6:
+                if (transactionManager.appendNewRows() == 0) {
+                    std::cout << "No new rows.\n";
+                }
+                break;
             case 0:
                 std::cout << "Exiting program. Goodbye!\n";
                 break;
@@ -0,0 +1,236 @@
+#include "parallel_csv_parser.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+
+namespace {
+
+// A row skipped in tolerant mode; line is relative to the chunk until the
+// chunk is consumed in order.
+struct RejectedRow {
+    long line;
+    ParseErrorKind kind;
+    std::string message;
+    std::string text;
+    RejectedRow* next;
+};
+
+struct ChunkSlot {
+    TransactionArray* rows = nullptr;
+    RejectedRow* rejected = nullptr;
+    long lineCount = 0;
+    // Where the chunk's last row ends; the next chunk is only valid if it
+    // started here.
+    const char* end = nullptr;
+    bool done = false;
+    bool failed = false;
+    long errorLine = 0;
+    std::string error;
+};
+
+const char* alignToLineStart(const char* p, const char* end) {
+    if (p >= end) return end;
+    if (p[-1] == '\n') return p;
+    const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    return nl ? nl + 1 : end;
+}
+
+void freeChunk(ChunkSlot& slot) {
+    delete slot.rows;
+    slot.rows = nullptr;
+    while (slot.rejected != nullptr) {
+        RejectedRow* row = slot.rejected;
+        slot.rejected = row->next;
+        delete row;
+    }
+}
+
+// Parses the rows that start in [from, stop) into slot. The last one may run
+// on past stop (a quoted field with newlines), so the reader is bounded by
+// end and slot.end records where that row really finished. The chunk only
+// takes the quote-aware path if it has a quote of its own.
+void parseChunk(const char* from, const char* stop, const char* end, const CsvColumnLayout& layout,
+                const CsvParseOptions& options, ChunkSlot& slot) {
+    const bool hasQuotes = from < stop && std::memchr(from, '"', stop - from) != nullptr;
+    MappedCsvReader reader(from, end, layout, 1, hasQuotes ? CsvQuoting::RFC4180 : CsvQuoting::NONE);
+    slot.rows = new TransactionArray(from < stop ? estimateCsvRowCount(from, stop) : 16, options.textStorage);
+    RejectedRow** rejectedTail = &slot.rejected;
+    CsvField fields[CSV_COLUMN_COUNT];
+    while (true) {
+        bool more = true;
+        try {
+            more = reader.readRow(fields);
+            if (more && reader.getRowText().data < stop) {
+                // The text is copied once, from the mapped bytes into the
+                // chunk's store.
+                Transaction tx;
+                TransactionTextView text;
+                fillTransactionFromFields(fields, tx, text, options.columns);
+                slot.rows->addTransaction(tx, text);
+                continue;
+            }
+        } catch (const std::exception& e) {
+            CsvField text = reader.getRowText();
+            if (text.data < stop) {
+                if (options.rejects == nullptr) {
+                    slot.failed = true;
+                    slot.errorLine = reader.getLineNumber();
+                    slot.error = e.what();
+                    slot.end = reader.getPosition();
+                    return;
+                }
+                *rejectedTail = new RejectedRow{reader.getLineNumber(), classifyParseError(e), e.what(),
+                                                std::string(text.data, text.length), nullptr};
+                rejectedTail = &(*rejectedTail)->next;
+                continue;
+            }
+        }
+        if (more) {
+            // This row starts the next chunk: it is not ours.
+            slot.end = reader.getRowText().data;
+            slot.lineCount = reader.getLineNumber() - 1;
+        } else {
+            slot.end = reader.getPosition();
+            slot.lineCount = reader.getNextLineNumber() - 1;
+        }
+        return;
+    }
+}
+
+}
+
+int resolveThreadCount(int requested) {
+    if (requested > 0) return requested;
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 0 ? static_cast<int>(cores) : 1;
+}
+
+void parseCsvChunksInOrder(const char* begin, const char* end, const CsvColumnLayout& layout,
+                           int threadCount, const std::function<bool(TransactionArray& rows)>& consume,
+                           const CsvParseOptions& options) {
+    const std::size_t maxChunkBytes = options.maxChunkBytes;
+    const int threads = resolveThreadCount(threadCount);
+    const std::size_t total = static_cast<std::size_t>(end - begin);
+    if (total == 0) return;
+
+    const std::size_t minChunkBytes = maxChunkBytes < (1u << 20) ? maxChunkBytes : (1u << 20);
+    std::size_t chunkBytes = total / (static_cast<std::size_t>(threads) * 8);
+    if (chunkBytes < minChunkBytes) chunkBytes = minChunkBytes;
+    if (chunkBytes > maxChunkBytes) chunkBytes = maxChunkBytes;
+    const long chunkCount = static_cast<long>((total + chunkBytes - 1) / chunkBytes);
+
+    // Chunks start at a line start, which is only a guess when a quoted
+    // field holds newlines: each chunk is checked against where the one
+    // before it really ended as it is consumed, and parsed again if it
+    // started inside a row. Nothing reads the file ahead of the workers.
+    const char** bounds = new const char*[chunkCount + 1];
+    bounds[0] = begin;
+    for (long i = 1; i < chunkCount; ++i) {
+        const char* aligned = alignToLineStart(begin + i * chunkBytes, end);
+        bounds[i] = aligned > bounds[i - 1] ? aligned : bounds[i - 1];
+    }
+    bounds[chunkCount] = end;
+
+    ChunkSlot* slots = new ChunkSlot[chunkCount];
+    std::mutex m;
+    std::condition_variable cv;
+    long nextToParse = 0;
+    long nextToConsume = 0;
+    bool stop = false;
+    const long window = threads * 2L;
+
+    auto worker = [&]() {
+        while (true) {
+            long index;
+            {
+                std::unique_lock<std::mutex> lk(m);
+                cv.wait(lk, [&] {
+                    return stop || nextToParse >= chunkCount || nextToParse < nextToConsume + window;
+                });
+                if (stop || nextToParse >= chunkCount) return;
+                index = nextToParse++;
+            }
+
+            // Only this thread touches the slot until done is set.
+            parseChunk(bounds[index], bounds[index + 1], end, layout, options, slots[index]);
+            {
+                std::lock_guard<std::mutex> lk(m);
+                slots[index].done = true;
+            }
+            cv.notify_all();
+        }
+    };
+
+    std::thread* pool = new std::thread[threads];
+    for (int t = 0; t < threads; ++t) {
+        pool[t] = std::thread(worker);
+    }
+
+    long linesBefore = options.firstLineNumber - 1;
+    const char* chunkStart = begin;
+    std::string failure;
+    std::exception_ptr consumerError;
+    for (long i = 0; i < chunkCount; ++i) {
+        ChunkSlot& slot = slots[i];
+        {
+            std::unique_lock<std::mutex> lk(m);
+            cv.wait(lk, [&] { return slot.done; });
+        }
+        if (bounds[i] != chunkStart) {
+            // The previous row ran past this chunk's guessed start.
+            freeChunk(slot);
+            slot = ChunkSlot();
+            parseChunk(chunkStart, bounds[i + 1], end, layout, options, slot);
+        }
+
+        while (slot.rejected != nullptr) {
+            RejectedRow* row = slot.rejected;
+            options.rejects->record(options.sourceName, linesBefore + row->line, row->kind, row->message,
+                                    row->text.data(), row->text.size());
+            slot.rejected = row->next;
+            delete row;
+        }
+
+        bool keepGoing = true;
+        try {
+            keepGoing = consume(*slot.rows);
+        } catch (...) {
+            consumerError = std::current_exception();
+            keepGoing = false;
+        }
+        if (keepGoing && slot.failed) {
+            failure = "line " + std::to_string(linesBefore + slot.errorLine) + ": " + slot.error;
+            keepGoing = false;
+        }
+        delete slot.rows;
+        slot.rows = nullptr;
+        linesBefore += slot.lineCount;
+        releaseMappedRange(chunkStart, slot.end);
+        chunkStart = slot.end;
+
+        {
+            std::lock_guard<std::mutex> lk(m);
+            nextToConsume = i + 1;
+            if (!keepGoing) stop = true;
+        }
+        cv.notify_all();
+        if (!keepGoing) break;
+    }
+
+    for (int t = 0; t < threads; ++t) {
+        pool[t].join();
+    }
+    delete[] pool;
+    for (long i = 0; i < chunkCount; ++i) {
+        freeChunk(slots[i]);
+    }
+    delete[] slots;
+    delete[] bounds;
+
+    if (consumerError) std::rethrow_exception(consumerError);
+    if (!failure.empty()) throw std::runtime_error(failure);
+}
@@ -0,0 +1,44 @@
+#ifndef PARALLEL_CSV_PARSER_H
+#define PARALLEL_CSV_PARSER_H
+
+#include <functional>
+#include <string>
+#include "fast_csv_reader.h"
+#include "custom_data_structures.h"
+#include "csv_reject_log.h"
+
+// 0 (or less) means one thread per hardware core.
+int resolveThreadCount(int requested);
+
+struct CsvParseOptions {
+    // Upper bound on the bytes parsed per chunk.
+    std::size_t maxChunkBytes = 64u << 20;
+    // Only these columns are converted (see fillTransactionFromFields).
+    CsvColumnSet columns = ALL_CSV_COLUMNS;
+    // How the chunk arrays keep their text; matching the container the rows
+    // end up in lets it adopt each chunk's text (TransactionArray::adoptRows)
+    // instead of copying it again.
+    TextStorage textStorage = TextStorage::ARENA;
+    // Tolerant mode: malformed rows are recorded here under sourceName, with
+    // their absolute line number, and skipped instead of failing the parse.
+    CsvRejectLog* rejects = nullptr;
+    std::string sourceName;
+    // Line number of the first row in [begin, end); 2 when begin is just
+    // past the header.
+    long firstLineNumber = 2;
+};
+
+// Splits [begin, end) into byte ranges aligned to line boundaries and parses
+// them on threadCount workers; a range that turns out to start inside a
+// quoted field is parsed again from where the row really ended. Each chunk's
+// rows are passed to consume on the calling thread, strictly in file order;
+// consume may move them out and can return false to stop early. Only a small window of chunks is in flight at
+// once, so memory stays bounded regardless of file size; options.maxChunkBytes
+// caps the size of each chunk to tighten that bound further.
+// Without options.rejects, throws std::runtime_error (with the absolute line
+// number) on the first malformed row.
+void parseCsvChunksInOrder(const char* begin, const char* end, const CsvColumnLayout& layout,
+                           int threadCount, const std::function<bool(TransactionArray& rows)>& consume,
+                           const CsvParseOptions& options = CsvParseOptions());
+
+#endif
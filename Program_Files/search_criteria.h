@@ -0,0 +1,41 @@
+#ifndef SEARCH_CRITERIA_H
+#define SEARCH_CRITERIA_H
+
+#include <string>
+#include "transaction.h"
+#include "transaction_fields.h"
+#include "transaction_store.h"
+
+struct SearchCriteria {
+    static const int ANY_CATEGORY = -1;
+    static const int NO_SUCH_CATEGORY = -2;
+
+    std::string transactionType;
+    std::string location;
+    std::string paymentChannel;
+    double minAmount;
+    double maxAmount;
+    bool hasAmountRange;
+    bool isFraudOnly;
+    // Dictionary codes for transactionType and paymentChannel, and one bit
+    // per location code whose name contains `location`, set by
+    // resolveCategoryFilters(); matchesCriteria tests these, not the text.
+    int transactionTypeCode;
+    int paymentChannelCode;
+    uint64_t locationCodeMatches[MAX_CATEGORY_VALUES / 64];
+    
+    SearchCriteria() : minAmount(0), maxAmount(0), hasAmountRange(false), isFraudOnly(false),
+                       transactionTypeCode(ANY_CATEGORY), paymentChannelCode(ANY_CATEGORY) {}
+};
+
+// Looks up the text filters (case-insensitively) in the column dictionaries.
+// The location filter stays a substring match, evaluated once per location.
+// Must be called again if rows with new values may have been loaded since.
+void resolveCategoryFilters(SearchCriteria& criteria);
+
+bool matchesCriteria(const Transaction& tx, const SearchCriteria& criteria);
+// The same test on one row of the columnar store, reading only the filtered
+// columns.
+bool matchesCriteria(const TransactionStore& store, int row, const SearchCriteria& criteria);
+
+#endif
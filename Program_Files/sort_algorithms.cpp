@@ -0,0 +1,70 @@
+#include "sort_algorithms.h"
+
+void radixSortOrder(uint64_t* keys, int count, int* order) {
+    if (count <= 0) return;
+
+    // One read of the keys counts the values of all eight bytes.
+    int (*counts)[256] = new int[8][256]();
+    for (int i = 0; i < count; ++i) {
+        order[i] = i;
+        for (int pass = 0; pass < 8; ++pass) {
+            counts[pass][(keys[i] >> (pass * 8)) & 0xFF]++;
+        }
+    }
+
+    uint64_t* keyScratch = new uint64_t[count];
+    int* orderScratch = new int[count];
+    uint64_t* fromKeys = keys;
+    int* fromOrder = order;
+    uint64_t* toKeys = keyScratch;
+    int* toOrder = orderScratch;
+    for (int pass = 0; pass < 8; ++pass) {
+        const int shift = pass * 8;
+        int* bucket = counts[pass];
+        if (bucket[(fromKeys[0] >> shift) & 0xFF] == count) {
+            continue;
+        }
+        int offset = 0;
+        for (int b = 0; b < 256; ++b) {
+            int n = bucket[b];
+            bucket[b] = offset;
+            offset += n;
+        }
+        for (int i = 0; i < count; ++i) {
+            int to = bucket[(fromKeys[i] >> shift) & 0xFF]++;
+            toKeys[to] = fromKeys[i];
+            toOrder[to] = fromOrder[i];
+        }
+        std::swap(fromKeys, toKeys);
+        std::swap(fromOrder, toOrder);
+    }
+    if (fromOrder != order) {
+        std::memcpy(keys, fromKeys, sizeof(uint64_t) * count);
+        std::memcpy(order, fromOrder, sizeof(int) * count);
+    }
+
+    delete[] keyScratch;
+    delete[] orderScratch;
+    delete[] counts;
+}
+
+void sortKeyOrder(uint64_t* keys, int count, int algoChoice, int* order, int threads) {
+    if (algoChoice == 3) {
+        radixSortOrder(keys, count, order);
+        return;
+    }
+    SortEntry* entries = new SortEntry[count];
+    for (int i = 0; i < count; ++i) {
+        entries[i].key = keys[i];
+        entries[i].row = i;
+    }
+    if (algoChoice == 1) {
+        quickSortArray(entries, 0, count - 1, SortEntryLess());
+    } else {
+        parallelMergeSortArray(entries, count, SortEntryLess(), threads);
+    }
+    for (int i = 0; i < count; ++i) {
+        order[i] = entries[i].row;
+    }
+    delete[] entries;
+}
@@ -0,0 +1,498 @@
+#ifndef SORT_ALGORITHMS_H
+#define SORT_ALGORITHMS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+#include "transaction.h"
+#include "custom_data_structures.h"
+#include "transaction_fields.h"
+#include "transaction_manager.h"
+
+// The sorts are templates over the comparator, so each one is compiled per
+// comparator type and the comparison is inlined into its loops. Pass one of
+// the TransactionLess types below (or a lambda); a std::function still works
+// but calls through it on every comparison.
+
+// "Location", "Amount" or "Timestamp".
+std::string getFieldName(SortField field);
+
+// "Sorts before" for one SortField. Each field is its own type, so choosing
+// the field happens once, in withTransactionLess(), instead of in every
+// comparison.
+template <SortField Field>
+struct TransactionLess;
+
+template <>
+struct TransactionLess<SortField::AMOUNT> {
+    bool operator()(const Transaction& a, const Transaction& b) const { return a.amount < b.amount; }
+};
+
+template <>
+struct TransactionLess<SortField::TIMESTAMP> {
+    bool operator()(const Transaction& a, const Transaction& b) const { return a.timestamp < b.timestamp; }
+};
+
+// Locations sort by the alphabetical rank of their codes.
+template <>
+struct TransactionLess<SortField::LOCATION> {
+    const CategoryRanks* ranks;
+    bool operator()(const Transaction& a, const Transaction& b) const {
+        return (*ranks)[a.location] < (*ranks)[b.location];
+    }
+};
+
+// By location name, for rows that may carry codes the rank table was built
+// without (streaming batches).
+struct LocationNameLess {
+    bool operator()(const Transaction& a, const Transaction& b) const {
+        return categoryName(CATEGORY_LOCATION, a.location) < categoryName(CATEGORY_LOCATION, b.location);
+    }
+};
+
+// Calls sort(less) with the comparator for field; with locationRanks null,
+// locations compare by name.
+template <typename Sort>
+void withTransactionLess(SortField field, const CategoryRanks* locationRanks, Sort sort) {
+    switch (field) {
+        case SortField::AMOUNT:
+            sort(TransactionLess<SortField::AMOUNT>());
+            break;
+        case SortField::TIMESTAMP:
+            sort(TransactionLess<SortField::TIMESTAMP>());
+            break;
+        default:
+            if (locationRanks) {
+                sort(TransactionLess<SortField::LOCATION>{locationRanks});
+            } else {
+                sort(LocationNameLess());
+            }
+            break;
+    }
+}
+
+// The array sorts work on records or on any other copyable element, such as
+// the SortEntry of an index sort.
+template <typename T, typename Compare>
+void quickSortArray(T* arr, int left, int right, const Compare& comp) {
+    if (left >= right) return;
+    T pivot = arr[(left + right) / 2];
+    int i = left, j = right;
+    while (i <= j) {
+        while (comp(arr[i], pivot)) i++;
+        while (comp(pivot, arr[j])) j--;
+        if (i <= j) {
+            std::swap(arr[i], arr[j]);
+            i++; j--;
+        }
+    }
+    quickSortArray(arr, left, j, comp);
+    quickSortArray(arr, i, right, comp);
+}
+
+// Merges the sorted arr[0, mid) and arr[mid, count). Only the left half is
+// copied out, to scratch[0, mid); ties go to it, so the merge is stable.
+template <typename T, typename Compare>
+void merge(T* arr, T* scratch, int mid, int count, const Compare& comp) {
+    if (!comp(arr[mid], arr[mid - 1])) return;
+    std::copy(arr, arr + mid, scratch);
+    int i = 0, j = mid, k = 0;
+    while (i < mid && j < count) arr[k++] = comp(arr[j], scratch[i]) ? arr[j++] : scratch[i++];
+    while (i < mid) arr[k++] = scratch[i++];
+}
+
+// Sorts arr[0, count) using scratch[0, count) for every merge.
+template <typename T, typename Compare>
+void mergeSortRange(T* arr, T* scratch, int count, const Compare& comp) {
+    if (count < 2) return;
+    int mid = count / 2;
+    mergeSortRange(arr, scratch, mid, comp);
+    mergeSortRange(arr + mid, scratch + mid, count - mid, comp);
+    merge(arr, scratch, mid, count, comp);
+}
+
+template <typename T, typename Compare>
+void mergeSortArray(T* arr, int left, int right, const Compare& comp) {
+    if (left >= right) return;
+    T* scratch = new T[right - left + 1];
+    mergeSortRange(arr + left, scratch, right - left + 1, comp);
+    delete[] scratch;
+}
+
+// Calls task(0) to task(threads - 1) on threads threads, the calling thread
+// being one of them, and returns once all have finished.
+template <typename Task>
+void runOnThreads(int threads, const Task& task) {
+    std::thread* pool = new std::thread[threads - 1];
+    for (int t = 1; t < threads; ++t) {
+        pool[t - 1] = std::thread([&task, t]() { task(t); });
+    }
+    task(0);
+    for (int t = 1; t < threads; ++t) {
+        pool[t - 1].join();
+    }
+    delete[] pool;
+}
+
+// items holds runs sorted runs, run r being [runStart[r], runStart[r + 1]).
+// Sets split[r] so that the items before split[r] in every run are the
+// first rank items of the runs' stable merge (ties go to the lower run).
+// Each step takes the middle of the widest remaining range as a pivot,
+// counts what merges ahead of it by a binary search in every run and keeps
+// the half of each range the split must be in.
+template <typename T, typename Compare>
+void splitSortedRuns(const T* items, const int* runStart, int runs, int rank, const Compare& comp, int* split) {
+    int* hi = new int[runs];
+    int* ahead = new int[runs];
+    for (int r = 0; r < runs; ++r) {
+        split[r] = runStart[r];
+        hi[r] = runStart[r + 1];
+    }
+    while (true) {
+        int widest = -1;
+        for (int r = 0; r < runs; ++r) {
+            if (hi[r] > split[r] && (widest < 0 || hi[r] - split[r] > hi[widest] - split[widest])) widest = r;
+        }
+        if (widest < 0) break;
+        const int mid = split[widest] + (hi[widest] - split[widest]) / 2;
+        const T& pivot = items[mid];
+        long before = 0;
+        for (int r = 0; r < runs; ++r) {
+            const T* first = items + runStart[r];
+            const T* last = items + runStart[r + 1];
+            ahead[r] = r == widest ? mid
+                     : static_cast<int>((r < widest ? std::upper_bound(first, last, pivot, comp)
+                                                    : std::lower_bound(first, last, pivot, comp)) - items);
+            before += ahead[r] - runStart[r];
+        }
+        if (before < rank) {
+            for (int r = 0; r < runs; ++r) split[r] = std::max(split[r], ahead[r]);
+            split[widest] = mid + 1;
+        } else {
+            for (int r = 0; r < runs; ++r) hi[r] = std::min(hi[r], ahead[r]);
+            hi[widest] = mid;
+        }
+    }
+    delete[] ahead;
+    delete[] hi;
+}
+
+// Merges the parts [from[r], to[r]) of runs sorted runs of items into out,
+// always taking the smallest head (from the lowest run on ties) off a heap.
+template <typename T, typename Compare>
+void mergeRuns(const T* items, int* from, const int* to, int runs, T* out, const Compare& comp) {
+    int* heap = new int[runs];
+    int heapSize = 0;
+    // std::push_heap keeps the greatest on top, so "less" here means later.
+    auto later = [&](int a, int b) {
+        return comp(items[from[b]], items[from[a]]) || (!comp(items[from[a]], items[from[b]]) && b < a);
+    };
+    for (int r = 0; r < runs; ++r) {
+        if (from[r] < to[r]) {
+            heap[heapSize++] = r;
+            std::push_heap(heap, heap + heapSize, later);
+        }
+    }
+    while (heapSize > 0) {
+        std::pop_heap(heap, heap + heapSize, later);
+        const int r = heap[heapSize - 1];
+        *out++ = items[from[r]++];
+        if (from[r] < to[r]) {
+            std::push_heap(heap, heap + heapSize, later);
+        } else {
+            --heapSize;
+        }
+    }
+    delete[] heap;
+}
+
+// Stable merge sort of arr[0, count) on threads threads, with one scratch
+// buffer for the whole sort: each thread merge sorts an equal slice and
+// copies it to scratch, then each thread splits the runs at its share of
+// the output (splitSortedRuns) and multiway merges that share back into arr.
+template <typename T, typename Compare>
+void parallelMergeSortArray(T* arr, int count, const Compare& comp, int threads) {
+    // Below a few thousand rows per thread the threads cost more than they save.
+    if (threads > count / 4096) threads = count / 4096;
+    if (threads <= 1) {
+        mergeSortArray(arr, 0, count - 1, comp);
+        return;
+    }
+    T* scratch = new T[count];
+    int* runStart = new int[threads + 1];
+    for (int t = 0; t <= threads; ++t) {
+        runStart[t] = static_cast<int>(static_cast<long long>(count) * t / threads);
+    }
+    runOnThreads(threads, [&](int t) {
+        const int first = runStart[t];
+        const int length = runStart[t + 1] - first;
+        mergeSortRange(arr + first, scratch + first, length, comp);
+        std::copy(arr + first, arr + first + length, scratch + first);
+    });
+    runOnThreads(threads, [&](int t) {
+        int* from = new int[threads];
+        int* to = new int[threads];
+        splitSortedRuns(scratch, runStart, threads, runStart[t], comp, from);
+        splitSortedRuns(scratch, runStart, threads, runStart[t + 1], comp, to);
+        mergeRuns(scratch, from, to, threads, arr + runStart[t], comp);
+        delete[] to;
+        delete[] from;
+    });
+    delete[] runStart;
+    delete[] scratch;
+}
+
+// The columnar store is sorted through a permutation: these order row
+// indices by a key read from the columns, and TransactionStore::reorder()
+// then moves every column once.
+template <typename Compare>
+void quickSortIndices(int* order, int left, int right, const Compare& comp) {
+    if (left >= right) return;
+    int pivot = order[(left + right) / 2];
+    int i = left, j = right;
+    while (i <= j) {
+        while (comp(order[i], pivot)) i++;
+        while (comp(pivot, order[j])) j--;
+        if (i <= j) {
+            std::swap(order[i], order[j]);
+            i++; j--;
+        }
+    }
+    quickSortIndices(order, left, j, comp);
+    quickSortIndices(order, i, right, comp);
+}
+
+template <typename Compare>
+void mergeSortIndices(int* order, int* scratch, int left, int right, const Compare& comp) {
+    if (left >= right) return;
+    int mid = left + (right - left) / 2;
+    mergeSortIndices(order, scratch, left, mid, comp);
+    mergeSortIndices(order, scratch, mid + 1, right, comp);
+    int i = left, j = mid + 1, k = left;
+    while (i <= mid && j <= right) scratch[k++] = comp(order[j], order[i]) ? order[j++] : order[i++];
+    while (i <= mid) scratch[k++] = order[i++];
+    while (j <= right) scratch[k++] = order[j++];
+    for (k = left; k <= right; ++k) order[k] = scratch[k];
+}
+
+// Ties go to a, the earlier part of the list, so the list sorts are stable.
+template <typename Compare>
+TransactionNode* mergeSortedLists(TransactionNode* a, TransactionNode* b, const Compare& comp) {
+    if (!a) return b;
+    if (!b) return a;
+
+    TransactionNode* result = nullptr;
+    TransactionNode* tail = nullptr;
+
+    while (a && b) {
+        if (!comp(b->data, a->data)) {
+            if (!result) {
+                result = tail = a;
+            } else {
+                tail->next = a;
+                tail = a;
+            }
+            a = a->next;
+        } else {
+            if (!result) {
+                result = tail = b;
+            } else {
+                tail->next = b;
+                tail = b;
+            }
+            b = b->next;
+        }
+    }
+
+    if (tail) {
+        tail->next = a ? a : b;
+    } else {
+        result = a ? a : b;
+    }
+
+    return result;
+}
+
+inline void splitList(TransactionNode* source, TransactionNode** front, TransactionNode** back) {
+    TransactionNode* slow = source;
+    TransactionNode* fast = source->next;
+    while (fast) {
+        fast = fast->next;
+        if (fast) {
+            slow = slow->next;
+            fast = fast->next;
+        }
+    }
+    *front = source;
+    *back = slow->next;
+    slow->next = nullptr;
+}
+
+template <typename Compare>
+TransactionNode* mergeSortLinkedList(TransactionNode* head, const Compare& comp) {
+    if (!head || !head->next) return head;
+    TransactionNode* a;
+    TransactionNode* b;
+    splitList(head, &a, &b);
+    a = mergeSortLinkedList(a, comp);
+    b = mergeSortLinkedList(b, comp);
+    return mergeSortedLists(a, b, comp);
+}
+
+template <typename Compare>
+TransactionNode* mergeSortLinkedListIterative(TransactionNode* head, const Compare& comp) {
+    if (!head || !head->next) return head;
+
+    int length = 0;
+    TransactionNode* current = head;
+    while (current) {
+        length++;
+        current = current->next;
+    }
+
+    for (int size = 1; size < length; size *= 2) {
+        TransactionNode* newHead = nullptr;
+        TransactionNode* tail = nullptr;
+        TransactionNode* curr = head;
+
+        while (curr) {
+            TransactionNode* first = curr;
+            int firstSize = 0;
+
+            while (curr && firstSize < size - 1) {
+                curr = curr->next;
+                firstSize++;
+            }
+
+            if (!curr || !curr->next) {
+                if (!newHead) {
+                    newHead = first;
+                } else {
+                    tail->next = first;
+                }
+                break;
+            }
+
+            TransactionNode* secondStart = curr->next;
+            curr->next = nullptr;
+            curr = secondStart;
+
+            TransactionNode* second = secondStart;
+            int secondSize = 0;
+
+            while (curr && secondSize < size - 1) {
+                curr = curr->next;
+                secondSize++;
+            }
+
+            TransactionNode* nextStart = nullptr;
+            if (curr) {
+                nextStart = curr->next;
+                curr->next = nullptr;
+            }
+
+            TransactionNode* merged = mergeSortedLists(first, second, comp);
+
+            if (!newHead) {
+                newHead = merged;
+            } else {
+                tail->next = merged;
+            }
+
+            tail = merged;
+            while (tail->next) {
+                tail = tail->next;
+            }
+
+            curr = nextStart;
+        }
+
+        head = newHead;
+    }
+
+    return head;
+}
+
+// Sort keys: each row's key turned into an unsigned integer whose order is
+// the field's order. The LSD radix sort sorts them a byte at a time
+// (stable, so equal keys keep their order), and the index sort sorts them
+// paired with row numbers; both give a permutation that the caller applies
+// to the rows once, or reads the rows through.
+
+// Positive doubles keep their order as bit patterns once the sign bit is
+// set; negative ones reverse it, so all their bits are flipped.
+inline uint64_t radixKey(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | (uint64_t(1) << 63);
+}
+
+inline uint64_t radixKey(int64_t value) {
+    return static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+}
+
+// The sort key of every row in [first, last) for field; locations use the
+// alphabetical rank of their code.
+template <typename Iterator>
+void fillSortKeys(Iterator first, Iterator last, SortField field, const CategoryRanks& locationRanks, uint64_t* keys) {
+    switch (field) {
+        case SortField::AMOUNT:
+            for (; first != last; ++first) *keys++ = radixKey((*first).amount);
+            break;
+        case SortField::TIMESTAMP:
+            for (; first != last; ++first) *keys++ = radixKey((*first).timestamp);
+            break;
+        default:
+            for (; first != last; ++first) *keys++ = locationRanks[(*first).location];
+            break;
+    }
+}
+
+// Sorts keys[0, count) and sets order[i] to the original position of the
+// key that ends up at i. Bytes that are the same in every key are skipped,
+// so a 16-bit key costs two passes.
+void radixSortOrder(uint64_t* keys, int count, int* order);
+
+// A row's sort key next to its index: what an index sort moves instead of
+// the record. Ties go to the lower row, so the sorted order is the stable
+// one whichever algorithm produced it.
+struct SortEntry {
+    uint64_t key;
+    int row;
+};
+
+struct SortEntryLess {
+    bool operator()(const SortEntry& a, const SortEntry& b) const {
+        return a.key < b.key || (a.key == b.key && a.row < b.row);
+    }
+};
+
+// The stable order of keys[0, count), as radixSortOrder() gives it:
+// algoChoice 1 quick sorts and 2 merge sorts (key, row) entries, the merge
+// sort on threads threads, 3 radix sorts the keys themselves.
+void sortKeyOrder(uint64_t* keys, int count, int algoChoice, int* order, int threads = 1);
+
+// Rearranges items so that item i becomes the old items[order[i]], moving
+// each item once by following the permutation's cycles. order is left as
+// the identity.
+template <typename T>
+void applyOrder(T* items, int* order, int count) {
+    for (int start = 0; start < count; ++start) {
+        if (order[start] == start) continue;
+        T held = items[start];
+        int at = start;
+        while (order[at] != start) {
+            int from = order[at];
+            items[at] = items[from];
+            order[at] = at;
+            at = from;
+        }
+        items[at] = held;
+        order[at] = at;
+    }
+}
+
+#endif
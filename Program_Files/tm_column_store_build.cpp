@@ -0,0 +1,33 @@
+#include "transaction_manager.h"
+#include <iostream>
+#include <chrono>
+
+void TransactionManager::ensureColumnStore() {
+    if (columnStoreReady || streamingMode) {
+        return;
+    }
+    // A background list build only reads the array, as this does.
+    std::cout << Color::CYAN << "Building TransactionStore (columnar) from " << transactionsArray.getSize()
+              << " loaded transactions..." << Color::RESET << "\n";
+    auto start = std::chrono::high_resolution_clock::now();
+    TransactionStore built(transactionsArray.getSize());
+    // Through the view, if a sort left one, so the copy is in sorted order.
+    auto copyRows = [&built](const auto& source) {
+        for (const Transaction& tx : source) {
+            built.addTransaction(tx, source.getText(tx));
+        }
+    };
+    if (transactionsArrayView.isActive()) {
+        copyRows(transactionsArrayView);
+    } else {
+        copyRows(transactionsArray);
+    }
+    transactionsColumns = std::move(built);
+    auto end = std::chrono::high_resolution_clock::now();
+    columnBuildMs = std::chrono::duration<double, std::milli>(end - start).count();
+    columnsSorted = arraySorted;
+    columnsSortField = arraySortField;
+    columnStoreReady = true;
+    std::cout << Color::CYAN << "⏱️  TransactionStore built on first use: " << columnBuildMs << " ms ("
+              << transactionsColumns.getMemoryBytes() / 1024 << " KB)" << Color::RESET << "\n";
+}
@@ -0,0 +1,160 @@
+#include "transaction_manager.h"
+#include "sort_algorithms.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+
+namespace {
+
+using GenericLess = std::function<bool(const Transaction&, const Transaction&)>;
+
+// The comparator the sorts took before they were templates: one
+// std::function for every field, switching on it for each pair.
+GenericLess makeGenericLess(SortField field, const CategoryRanks& locationRanks) {
+    return [&locationRanks, field](const Transaction& a, const Transaction& b) {
+        switch (field) {
+            case SortField::LOCATION: return locationRanks[a.location] < locationRanks[b.location];
+            case SortField::AMOUNT: return a.amount < b.amount;
+            case SortField::TIMESTAMP: return a.timestamp < b.timestamp;
+            default: return false;
+        }
+    };
+}
+
+template <typename Compare>
+struct CountingLess {
+    Compare less;
+    long* count;
+    bool operator()(const Transaction& a, const Transaction& b) const {
+        ++*count;
+        return less(a, b);
+    }
+};
+
+struct ComparatorRun {
+    long comparisons = 0;
+    double genericMs = 0;
+    double specializedMs = 0;
+    bool sameOrder = true;
+};
+
+// Merge sorts a fresh copy of the rows with each comparator. Both make the
+// same comparisons, so one counted pass gives the count for both.
+template <typename Compare>
+ComparatorRun timeArraySort(const Transaction* rows, int count, const GenericLess& generic, const Compare& specialized) {
+    ComparatorRun run;
+    Transaction* genericRows = new Transaction[count];
+    Transaction* specializedRows = new Transaction[count];
+
+    std::copy(rows, rows + count, genericRows);
+    mergeSortArray(genericRows, 0, count - 1, CountingLess<Compare>{specialized, &run.comparisons});
+
+    std::copy(rows, rows + count, genericRows);
+    auto start = std::chrono::high_resolution_clock::now();
+    mergeSortArray(genericRows, 0, count - 1, generic);
+    auto end = std::chrono::high_resolution_clock::now();
+    run.genericMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::copy(rows, rows + count, specializedRows);
+    start = std::chrono::high_resolution_clock::now();
+    mergeSortArray(specializedRows, 0, count - 1, specialized);
+    end = std::chrono::high_resolution_clock::now();
+    run.specializedMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    for (int i = 0; i < count && run.sameOrder; ++i) {
+        run.sameOrder = genericRows[i].textRow == specializedRows[i].textRow;
+    }
+    delete[] genericRows;
+    delete[] specializedRows;
+    return run;
+}
+
+template <typename Compare>
+ComparatorRun timeListSort(const TransactionLinkedList& rows, const GenericLess& generic, const Compare& specialized) {
+    ComparatorRun run;
+    {
+        TransactionLinkedList counted(rows);
+        counted.adoptSortedChain(mergeSortLinkedListIterative(counted.getHead(), CountingLess<Compare>{specialized, &run.comparisons}));
+    }
+
+    TransactionLinkedList genericList(rows);
+    auto start = std::chrono::high_resolution_clock::now();
+    genericList.adoptSortedChain(mergeSortLinkedListIterative(genericList.getHead(), generic));
+    auto end = std::chrono::high_resolution_clock::now();
+    run.genericMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    TransactionLinkedList specializedList(rows);
+    start = std::chrono::high_resolution_clock::now();
+    specializedList.adoptSortedChain(mergeSortLinkedListIterative(specializedList.getHead(), specialized));
+    end = std::chrono::high_resolution_clock::now();
+    run.specializedMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    TransactionNode* a = genericList.getHead();
+    TransactionNode* b = specializedList.getHead();
+    for (; a && b && run.sameOrder; a = a->next, b = b->next) {
+        run.sameOrder = a->data.textRow == b->data.textRow;
+    }
+    return run;
+}
+
+void printComparatorRow(const std::string& label, const ComparatorRun& run) {
+    double genericRate = run.genericMs > 0 ? run.comparisons / (run.genericMs * 1000.0) : 0.0;
+    double specializedRate = run.specializedMs > 0 ? run.comparisons / (run.specializedMs * 1000.0) : 0.0;
+    std::cout << std::left << std::setw(22) << label << std::right << std::setw(12) << run.comparisons
+              << std::setw(14) << genericRate << std::setw(14) << specializedRate << std::setw(9)
+              << (genericRate > 0 ? specializedRate / genericRate : 0.0) << "x"
+              << (run.sameOrder ? "" : Color::RED + "  order differs!" + Color::RESET) << "\n";
+}
+
+}
+
+void TransactionManager::compareSortComparators() {
+    if (streamingMode) {
+        std::cout << Color::YELLOW << "The comparator benchmark needs the rows in memory; it is not available in streaming mode."
+                  << Color::RESET << "\n";
+        return;
+    }
+    const CsvColumnSet keys = csvColumnBit(CSV_LOCATION) | csvColumnBit(CSV_AMOUNT) | csvColumnBit(CSV_TIMESTAMP);
+    if (!requireColumns(keys, "The comparator benchmark")) {
+        return;
+    }
+    const int count = transactionsArray.getSize();
+    if (count == 0) {
+        std::cout << "No transactions loaded.\n";
+        return;
+    }
+
+    std::cout << "\n" << Color::BRIGHT_MAGENTA << ">>> 🧮 Sort Comparator Comparison" << Color::RESET << "\n";
+    std::cout << Color::CYAN << "Merge sorting copies of " << count
+              << " rows by each field, through std::function and through the field's own comparator..."
+              << Color::RESET << "\n";
+    waitForBackgroundListBuild();
+    ensureLinkedList();
+
+    CategoryRanks locationRanks(CATEGORY_LOCATION);
+    const SortField fields[] = {SortField::LOCATION, SortField::AMOUNT, SortField::TIMESTAMP};
+    ComparatorRun arrayRuns[3], listRuns[3];
+    for (int f = 0; f < 3; ++f) {
+        GenericLess generic = makeGenericLess(fields[f], locationRanks);
+        withTransactionLess(fields[f], &locationRanks, [&](const auto& specialized) {
+            arrayRuns[f] = timeArraySort(transactionsArray.getDataPointer(), count, generic, specialized);
+            listRuns[f] = timeListSort(transactionsLinkedList, generic, specialized);
+        });
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n" << Color::BOLD << Color::BRIGHT_CYAN << "📊 Comparisons per Second (millions, MergeSort)"
+              << Color::RESET << "\n";
+    std::cout << std::string(72, '=') << "\n";
+    std::cout << std::left << std::setw(22) << "Field / structure" << std::right << std::setw(12) << "Compares"
+              << std::setw(14) << "std::function" << std::setw(14) << "specialized" << std::setw(10) << "Speedup" << "\n";
+    std::cout << std::string(72, '-') << "\n";
+    for (int f = 0; f < 3; ++f) {
+        printComparatorRow(getFieldName(fields[f]) + ", Array", arrayRuns[f]);
+        printComparatorRow(getFieldName(fields[f]) + ", LinkedList", listRuns[f]);
+    }
+    std::cout << std::string(72, '=') << "\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
@@ -0,0 +1,116 @@
+#include "transaction_manager.h"
+#include <iostream>
+#include <chrono>
+
+// Source is the array itself or, after a sort that left a view, the array
+// read through transactionsArrayView; either way the copy is in sorted order.
+template <typename Rows>
+static double buildListFromArray(const Rows& source, TransactionLinkedList& list) {
+    auto start = std::chrono::high_resolution_clock::now();
+    TransactionLinkedList built(source.getTextStorage());
+    for (int i = 0; i < source.getSize(); ++i) {
+        const Transaction& tx = *source.getTransaction(i);
+        built.addTransaction(tx, source.getText(tx));
+    }
+    list = std::move(built);
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void TransactionManager::startLinkedListBuild() {
+    // The columnar copy is rebuilt from the new rows, at once if it is the
+    // structure in use.
+    transactionsColumns = TransactionStore();
+    columnStoreReady = false;
+    if (activeStructure == DataStructureType::COLUMNAR) {
+        ensureColumnStore();
+    }
+    transactionsUnrolled = TransactionUnrolledList(textStorage);
+    unrolledListReady = false;
+    if (activeStructure == DataStructureType::UNROLLED_LIST) {
+        ensureUnrolledList();
+    }
+    if (listBuildMode == ListBuildMode::DURING_LOAD) {
+        linkedListReady = true;
+        return;
+    }
+    linkedListReady = false;
+    // The copy keeps the array's order.
+    listSorted = arraySorted;
+    listSortField = arraySortField;
+    if (listBuildMode == ListBuildMode::BACKGROUND) {
+        // Only this thread touches the list until it is joined; the array is
+        // read-only meanwhile (see waitForBackgroundListBuild).
+        listBuilder = std::thread([this]() {
+            listBuildMs = buildListFromArray(transactionsArray, transactionsLinkedList);
+        });
+    }
+    // Like the other copies, the list is needed at once if it is in use,
+    // e.g. after requireColumns() reloaded the file under it.
+    if (activeStructure == DataStructureType::LINKED_LIST) {
+        ensureLinkedList();
+    }
+}
+
+void TransactionManager::waitForBackgroundListBuild() {
+    if (!listBuilder.joinable()) {
+        return;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    listBuilder.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    linkedListReady = true;
+    std::cout << Color::CYAN << "⏱️  TransactionLinkedList was built in the background: " << listBuildMs << " ms ("
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms spent waiting for it)"
+              << Color::RESET << "\n";
+}
+
+void TransactionManager::ensureLinkedList() {
+    if (linkedListReady || streamingMode) {
+        return;
+    }
+    if (listBuilder.joinable()) {
+        waitForBackgroundListBuild();
+        return;
+    }
+    std::cout << Color::CYAN << "Building TransactionLinkedList from " << transactionsArray.getSize()
+              << " loaded transactions..." << Color::RESET << "\n";
+    if (transactionsArrayView.isActive()) {
+        listBuildMs = buildListFromArray(transactionsArrayView, transactionsLinkedList);
+    } else {
+        listBuildMs = buildListFromArray(transactionsArray, transactionsLinkedList);
+    }
+    listSorted = arraySorted;
+    listSortField = arraySortField;
+    linkedListReady = true;
+    std::cout << Color::CYAN << "⏱️  TransactionLinkedList built on first use: " << listBuildMs << " ms"
+              << Color::RESET << "\n";
+}
+
+void TransactionManager::ensureUnrolledList() {
+    if (unrolledListReady || streamingMode) {
+        return;
+    }
+    std::cout << Color::CYAN << "Building TransactionUnrolledList from " << transactionsArray.getSize()
+              << " loaded transactions..." << Color::RESET << "\n";
+    auto start = std::chrono::high_resolution_clock::now();
+    TransactionUnrolledList built(transactionsArray.getTextStorage());
+    auto copyRows = [&built](const auto& source) {
+        for (const Transaction& tx : source) {
+            built.addTransaction(tx, source.getText(tx));
+        }
+    };
+    if (transactionsArrayView.isActive()) {
+        copyRows(transactionsArrayView);
+    } else {
+        copyRows(transactionsArray);
+    }
+    transactionsUnrolled = std::move(built);
+    auto end = std::chrono::high_resolution_clock::now();
+    unrolledBuildMs = std::chrono::duration<double, std::milli>(end - start).count();
+    unrolledSorted = arraySorted;
+    unrolledSortField = arraySortField;
+    unrolledListReady = true;
+    std::cout << Color::CYAN << "⏱️  TransactionUnrolledList built on first use: " << unrolledBuildMs << " ms ("
+              << transactionsUnrolled.getBlockCount() << " blocks)" << Color::RESET << "\n";
+}
@@ -0,0 +1,193 @@
+#include "transaction_manager.h"
+#include "fast_csv_reader.h"
+#include "parallel_csv_parser.h"
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+
+namespace {
+
+struct FileLoad {
+    TransactionArray* rows = nullptr;
+    std::size_t bytes = 0;
+    int rowCount = 0;
+    double ms = 0;
+    bool ok = false;
+    std::string error;
+};
+
+// Parses one whole file into load.rows on the calling thread.
+void loadOneFile(const std::string& path, CsvColumnSet columns, TextStorage textStorage, CsvRejectLog* rejects,
+                 FileLoad& load) {
+    auto start = std::chrono::high_resolution_clock::now();
+    MappedCsvFile file;
+    if (!file.open(path)) {
+        load.error = "could not be opened";
+        return;
+    }
+    load.bytes = file.size();
+    const char* cursor = file.begin();
+    CsvColumnLayout layout;
+    if (!layout.parseHeader(cursor, file.end())) {
+        load.error = "invalid header";
+        return;
+    }
+
+    load.rows = new TransactionArray(estimateCsvRowCount(cursor, file.end()), textStorage);
+    CsvParseOptions options;
+    options.columns = columns;
+    options.textStorage = textStorage;
+    options.rejects = rejects;
+    options.sourceName = path;
+    try {
+        parseCsvChunksInOrder(cursor, file.end(), layout, 1, [&](TransactionArray& rows) {
+            load.rows->adoptRows(rows, rows.getSize());
+            return true;
+        }, options);
+        load.rowCount = load.rows->getSize();
+        load.ok = true;
+    } catch (const std::exception& e) {
+        load.error = e.what();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    load.ms = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+}
+
+bool TransactionManager::loadTransactionsFromFiles(const std::string& source, CsvColumnSet columns) {
+    std::string* paths = nullptr;
+    const int fileCount = expandCsvSources(source, paths);
+    if (fileCount == 0) {
+        std::cerr << "No CSV files match " << source << "\n";
+        delete[] paths;
+        return false;
+    }
+
+    loadedSourcePath = source;
+    multiFileSource = true;
+    arraySorted = listSorted = columnsSorted = unrolledSorted = false;
+    transactionsArrayView = TransactionArrayView();
+    int threads = resolveThreadCount(fileLoadThreadCount);
+    if (threads > fileCount) threads = fileCount;
+    const bool fillList = listBuildMode == ListBuildMode::DURING_LOAD;
+
+    std::cout << "Loading " << fileCount << " CSV files from " << source << " (memory-mapped, " << threads
+              << " file threads)" << (fillList ? " into BOTH Array and LinkedList...\n" : " into the Array...\n");
+    if (useLegacyCsvReader) {
+        std::cout << Color::YELLOW << "(--csv-reader applies to single files only; using the mapped reader)" << Color::RESET << "\n";
+    }
+
+    if (rejectLog != nullptr) rejectLog->resetCounts();
+    long memoryBefore = getMemoryUsageKB();
+    auto wallStart = std::chrono::high_resolution_clock::now();
+
+    // Each worker takes the next unclaimed file, so a slow file does not
+    // hold up the others.
+    FileLoad* loads = new FileLoad[fileCount];
+    std::atomic<int> nextFile(0);
+    auto worker = [&]() {
+        for (int i = nextFile++; i < fileCount; i = nextFile++) {
+            loadOneFile(paths[i], columns, textStorage, rejectLog, loads[i]);
+        }
+    };
+    std::thread* pool = new std::thread[threads];
+    for (int t = 0; t < threads; ++t) {
+        pool[t] = std::thread(worker);
+    }
+    for (int t = 0; t < threads; ++t) {
+        pool[t].join();
+    }
+    delete[] pool;
+    auto parsedTime = std::chrono::high_resolution_clock::now();
+
+    bool ok = true;
+    for (int i = 0; i < fileCount; ++i) {
+        if (!loads[i].ok) {
+            std::cerr << "Error reading " << paths[i] << ": " << loads[i].error << "\n";
+            ok = false;
+        }
+    }
+
+    // Merge in name order so the structures hold the files back to back.
+    int count = 0;
+    if (ok) {
+        int total = 0;
+        for (int i = 0; i < fileCount; ++i) {
+            total += loads[i].rowCount;
+        }
+        reserveForRows(total);
+        for (int i = 0; i < fileCount; ++i) {
+            // Each file's text moves into the array rather than being copied.
+            TransactionArray& rows = *loads[i].rows;
+            int take = rows.getSize();
+            if (rowLimit > 0 && count + take > rowLimit) {
+                take = rowLimit > count ? static_cast<int>(rowLimit - count) : 0;
+            }
+            if (fillList) {
+                for (int r = 0; r < take; ++r) {
+                    const Transaction& tx = *rows.getTransaction(r);
+                    transactionsLinkedList.addTransaction(tx, rows.getText(tx));
+                }
+            }
+            transactionsArray.adoptRows(rows, take);
+            count += take;
+            delete loads[i].rows;
+            loads[i].rows = nullptr;
+        }
+    }
+    auto wallEnd = std::chrono::high_resolution_clock::now();
+    long memoryAfter = getMemoryUsageKB();
+
+    if (ok) {
+        std::size_t totalBytes = 0;
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "-----------------------------------------\n";
+        std::cout << std::left << std::setw(40) << "File" << std::right << std::setw(10) << "Rows"
+                  << std::setw(10) << "MB" << std::setw(10) << "ms" << std::setw(10) << "MB/s" << "\n";
+        for (int i = 0; i < fileCount; ++i) {
+            const FileLoad& load = loads[i];
+            double mb = load.bytes / (1024.0 * 1024.0);
+            std::string name = paths[i];
+            std::size_t slash = name.find_last_of('/');
+            if (slash != std::string::npos) name = name.substr(slash + 1);
+            std::cout << std::left << std::setw(40) << name << std::right << std::setw(10) << load.rowCount
+                      << std::setw(10) << mb << std::setw(10) << load.ms << std::setw(10)
+                      << (load.ms > 0 ? mb / (load.ms / 1000.0) : 0.0) << "\n";
+            totalBytes += load.bytes;
+        }
+        double wallMs = std::chrono::duration<double, std::milli>(wallEnd - wallStart).count();
+        double totalMb = totalBytes / (1024.0 * 1024.0);
+        std::cout << "-----------------------------------------\n";
+        std::cout << "Parse (all files, wall):                " << std::chrono::duration<double, std::milli>(parsedTime - wallStart).count() << " ms\n";
+        std::cout << "Merge into the structures:              " << std::chrono::duration<double, std::milli>(wallEnd - parsedTime).count() << " ms\n";
+        std::cout << "Total wall time:                        " << wallMs << " ms (" << (wallMs > 0 ? totalMb / (wallMs / 1000.0) : 0.0) << " MB/s)\n";
+        std::cout << "Memory usage:                           " << memoryAfter - memoryBefore << " KB (current total: " << memoryAfter << " KB)\n";
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+
+    for (int i = 0; i < fileCount; ++i) {
+        delete loads[i].rows;
+    }
+    delete[] loads;
+    delete[] paths;
+    if (rejectLog != nullptr) rejectLog->printSummary("Loading " + source);
+    if (!ok) {
+        return false;
+    }
+
+    loadedByteOffset = 0;
+    startLinkedListBuild();
+    std::cout << "Transactions loaded successfully. Total: " << count << " transactions"
+              << (fillList ? " in each data structure.\n" : ".\n");
+    std::cout << "-----------------------------------------\n";
+    loadedColumns = columns;
+    return true;
+}
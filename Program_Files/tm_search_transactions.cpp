@@ -1,6 +1,8 @@
 // Complete TRUE Structure Search - ALL options use active structure
 #include "transaction_manager.h"
 #include "csv_json_processing.h"
+#include "search_criteria.h"
+#include "transaction_fields.h"
 #include <iostream>
 #include <string>
 #include <limits>
@@ -49,17 +51,79 @@ std::string trim(const std::string& str) {
     return str.substr(first, (last - first + 1));
 }
 
-struct SearchCriteria {
-    std::string transactionType;
-    std::string location;
-    std::string paymentChannel;
-    double minAmount;
-    double maxAmount;
-    bool hasAmountRange;
-    bool isFraudOnly;
-    
-    SearchCriteria() : minAmount(0), maxAmount(0), hasAmountRange(false), isFraudOnly(false) {}
-};
+static int resolveCategoryFilter(CategoryColumn column, const std::string& text) {
+    if (text.empty()) return SearchCriteria::ANY_CATEGORY;
+    int code = findCategoryIgnoreCase(column, text);
+    return code >= 0 ? code : SearchCriteria::NO_SUCH_CATEGORY;
+}
+
+void resolveCategoryFilters(SearchCriteria& criteria) {
+    criteria.transactionTypeCode = resolveCategoryFilter(CATEGORY_TRANSACTION_TYPE, criteria.transactionType);
+    criteria.paymentChannelCode = resolveCategoryFilter(CATEGORY_PAYMENT_CHANNEL, criteria.paymentChannel);
+    if (!criteria.location.empty()) {
+        findCategoriesContainingIgnoreCase(CATEGORY_LOCATION, criteria.location, criteria.locationCodeMatches);
+    }
+}
+
+bool matchesCriteria(const Transaction& tx, const SearchCriteria& criteria) {
+    if (criteria.transactionTypeCode != SearchCriteria::ANY_CATEGORY) {
+        if (tx.transaction_type != criteria.transactionTypeCode) {
+            return false;
+        }
+    }
+    if (!criteria.location.empty()) {
+        if (!((criteria.locationCodeMatches[tx.location / 64] >> (tx.location % 64)) & 1)) {
+            return false;
+        }
+    }
+    if (criteria.paymentChannelCode != SearchCriteria::ANY_CATEGORY) {
+        if (tx.payment_channel != criteria.paymentChannelCode) {
+            return false;
+        }
+    }
+    if (criteria.hasAmountRange) {
+        if (tx.amount < criteria.minAmount || tx.amount > criteria.maxAmount) {
+            return false;
+        }
+    }
+    if (criteria.isFraudOnly) {
+        if (!tx.is_fraud) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool matchesCriteria(const TransactionStore& store, int row, const SearchCriteria& criteria) {
+    if (criteria.transactionTypeCode != SearchCriteria::ANY_CATEGORY) {
+        if (store.getTransactionTypes()[row] != criteria.transactionTypeCode) {
+            return false;
+        }
+    }
+    if (!criteria.location.empty()) {
+        uint16_t location = store.getLocations()[row];
+        if (!((criteria.locationCodeMatches[location / 64] >> (location % 64)) & 1)) {
+            return false;
+        }
+    }
+    if (criteria.paymentChannelCode != SearchCriteria::ANY_CATEGORY) {
+        if (store.getPaymentChannels()[row] != criteria.paymentChannelCode) {
+            return false;
+        }
+    }
+    if (criteria.hasAmountRange) {
+        double amount = store.getAmounts()[row];
+        if (amount < criteria.minAmount || amount > criteria.maxAmount) {
+            return false;
+        }
+    }
+    if (criteria.isFraudOnly) {
+        if (!store.isFraud(row)) {
+            return false;
+        }
+    }
+    return true;
+}
 
 std::string generateUniqueFilename() {
     auto now = std::chrono::system_clock::now();
@@ -89,9 +153,178 @@ long getMemoryUsageKB() {
     return rss;
 }
 
+static void printSearchMatch(int matchCount, const Transaction& tx, const TransactionTextView& text) {
+    std::cout << Color::GREEN << "  [" << matchCount << "]" << Color::RESET 
+              << " ID: " << Color::YELLOW << text.transaction_id << Color::RESET
+              << " | Type: " << Color::BRIGHT_CYAN << categoryName(CATEGORY_TRANSACTION_TYPE, tx.transaction_type) << Color::RESET
+              << " | Amount: " << Color::BRIGHT_GREEN << "$" << tx.amount << Color::RESET
+              << " | Location: " << Color::MAGENTA << categoryName(CATEGORY_LOCATION, tx.location) << Color::RESET
+              << " | Channel: " << Color::BLUE << categoryName(CATEGORY_PAYMENT_CHANNEL, tx.payment_channel) << Color::RESET
+              << " | Fraud: " << (tx.is_fraud ? Color::RED + "YES" : Color::GREEN + "NO") << Color::RESET
+              << std::endl;
+}
+
+// Scans rows in their container's order. Every match is added to results,
+// a container of the same kind, and the first maxDisplay are printed.
+template <typename Rows, typename Results>
+static int collectMatches(const Rows& rows, const SearchCriteria& criteria, Results& results, int maxDisplay) {
+    int matchCount = 0;
+    for (const Transaction& tx : rows) {
+        if (!matchesCriteria(tx, criteria)) continue;
+        matchCount++;
+
+        TransactionTextView text = rows.getText(tx);
+        results.addTransaction(tx, text);
+
+        if (matchCount <= maxDisplay) {
+            printSearchMatch(matchCount, tx, text);
+        }
+
+        if (matchCount % 5000 == 0) {
+            std::cout << Color::YELLOW << "  ... found " << matchCount << " matches so far ..." << Color::RESET << "\n";
+        }
+    }
+    return matchCount;
+}
+
+template <typename Rows>
+static void copyRows(const Rows& rows, TransactionArray& into) {
+    for (const Transaction& tx : rows) {
+        into.addTransaction(tx, rows.getText(tx));
+    }
+}
+
+// Streaming mode: every batch is loaded into the active structure, scanned,
+// and released. Matches go straight to a JSON file, so memory use does not
+// grow with the number of results either.
+void performStreamingSearch(TransactionManager* manager, const SearchCriteria& criteria, const std::string& searchTitle) {
+    std::cout << "\n" << Color::CYAN << "=== " << searchTitle << " (STREAMING) ===" << Color::RESET << "\n";
+    std::cout << Color::BRIGHT_YELLOW << "🔥 ACTIVE STRUCTURE: " << manager->getCurrentDataStructureName() << Color::RESET << "\n";
+    std::cout << "Batch size: " << Color::CYAN << manager->getStreamBatchRows() << Color::RESET
+              << " rows (memory budget " << manager->getMemoryBudgetMB() << " MB)\n";
+    std::cout << Color::CYAN << "---------------------------------------------------" << Color::RESET << "\n";
+
+    std::string origin_suffix = "_" + manager->getActiveStructureTag() + ".json";
+    std::string filepath = "results/" + generateUniqueFilename() + "_stream" + origin_suffix;
+    std::string partialPath = filepath + ".part";
+    TransactionJsonWriter resultsWriter;
+    if (!resultsWriter.open(partialPath)) {
+        return;
+    }
+
+    const int MAX_DISPLAY = 15;
+    long matchCount = 0;
+    long scanned = 0;
+    long batches = 0;
+    SearchCriteria resolved = criteria;
+    resetPeakMemoryUsage();
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    auto onMatch = [&](const Transaction& tx, const TransactionTextView& text) {
+        matchCount++;
+        resultsWriter.write(tx, text);
+        if (matchCount <= MAX_DISPLAY) {
+            printSearchMatch(static_cast<int>(matchCount), tx, text);
+        }
+    };
+
+    bool completed = manager->forEachStreamBatch([&](TransactionArray& batch) {
+        batches++;
+        scanned += batch.getSize();
+        // A later batch may introduce the value being searched for.
+        resolveCategoryFilters(resolved);
+        if (manager->isUsingArray()) {
+            for (const Transaction& tx : batch) {
+                if (matchesCriteria(tx, resolved)) onMatch(tx, batch.getText(tx));
+            }
+        } else if (manager->isUsingColumns()) {
+            TransactionStore columns(batch.getSize());
+            for (int i = 0; i < batch.getSize(); ++i) {
+                const Transaction& tx = *batch.getTransaction(i);
+                columns.addTransaction(tx, batch.getText(tx));
+            }
+            for (int r = 0; r < columns.getSize(); ++r) {
+                if (matchesCriteria(columns, r, resolved)) onMatch(columns.getTransaction(r), columns.getText(r));
+            }
+        } else if (manager->isUsingUnrolledList()) {
+            TransactionUnrolledList list;
+            for (int i = 0; i < batch.getSize(); ++i) {
+                const Transaction& tx = *batch.getTransaction(i);
+                list.addTransaction(tx, batch.getText(tx));
+            }
+            for (const Transaction& tx : list) {
+                if (matchesCriteria(tx, resolved)) onMatch(tx, list.getText(tx));
+            }
+        } else {
+            TransactionLinkedList list;
+            for (int i = 0; i < batch.getSize(); ++i) {
+                Transaction& tx = *batch.getTransaction(i);
+                list.addTransaction(tx, batch.getText(tx));
+            }
+            for (const Transaction& tx : list) {
+                if (matchesCriteria(tx, resolved)) onMatch(tx, list.getText(tx));
+            }
+        }
+        return true;
+    });
+    resultsWriter.close();
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+
+    std::cout << Color::CYAN << "---------------------------------------------------" << Color::RESET << "\n";
+    std::cout << Color::BLUE << "[STATS]" << Color::RESET << " Scanned " << Color::YELLOW << scanned
+              << Color::RESET << " transactions in " << batches << " batches, "
+              << Color::YELLOW << Color::BOLD << matchCount << Color::RESET << " matches\n";
+    std::cout << Color::MAGENTA << "[TIME]" << Color::RESET 
+              << " Search time: " << Color::YELLOW << duration.count() 
+              << Color::RESET << " milliseconds\n";
+    std::cout << Color::BLUE << "[MEMORY]" << Color::RESET << " Peak RSS: " << Color::YELLOW
+              << getPeakMemoryUsageKB() << Color::RESET << " KB (budget " << manager->getMemoryBudgetMB() * 1024 << " KB)\n";
+    std::cout << Color::CYAN << "===================================" << Color::RESET << "\n";
+
+    if (!completed || matchCount == 0) {
+        std::remove(partialPath.c_str());
+        return;
+    }
+
+    std::cout << "\n" << Color::BRIGHT_YELLOW << "❓ Do you want to save these " << matchCount 
+              << " results to a JSON file? (y/n): " << Color::RESET;
+    char saveChoice;
+    std::cin >> saveChoice;
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+    if ((saveChoice == 'y' || saveChoice == 'Y') && std::rename(partialPath.c_str(), filepath.c_str()) == 0) {
+        std::cout << Color::BRIGHT_GREEN << "[SUCCESS]" << Color::RESET 
+                  << " Results saved to " << Color::YELLOW << filepath << Color::RESET << "\n";
+    } else {
+        std::remove(partialPath.c_str());
+        std::cout << Color::YELLOW << "[INFO]" << Color::RESET << " Results not saved." << std::endl;
+    }
+}
+
 void performUnifiedTrueSearch(TransactionManager* manager, const SearchCriteria& criteria, const std::string& searchTitle) {
+    if (manager->isStreaming()) {
+        performStreamingSearch(manager, criteria, searchTitle);
+        return;
+    }
+
+    // Every filter column, plus the ones shown in the result lines.
+    const CsvColumnSet searchColumns = csvColumnBit(CSV_TRANSACTION_ID) | csvColumnBit(CSV_TRANSACTION_TYPE) |
+                                       csvColumnBit(CSV_AMOUNT) | csvColumnBit(CSV_LOCATION) |
+                                       csvColumnBit(CSV_PAYMENT_CHANNEL) | csvColumnBit(CSV_IS_FRAUD);
+    if (!manager->requireColumns(searchColumns, searchTitle)) {
+        return;
+    }
+    // The list may still be empty or building after a load.
+    if (manager->getActiveStructure() == DataStructureType::LINKED_LIST) {
+        manager->ensureLinkedList();
+    }
+
     std::cout << "\n" << Color::CYAN << "=== " << searchTitle << " ===" << Color::RESET << "\n";
     
+    SearchCriteria resolved = criteria;
+    resolveCategoryFilters(resolved);
     TransactionArray resultsToSave;
     
     long memoryBefore = getMemoryUsageKB();
@@ -107,141 +340,55 @@ void performUnifiedTrueSearch(TransactionManager* manager, const SearchCriteria&
 
     if (manager->isUsingArray()) {
         std::cout << Color::GREEN << "📊 Using Array for BOTH search AND result storage" << Color::RESET << "\n";
-        
-        for (int i = 0; i < manager->getTransactionCount(); ++i) {
-            try {
-                Transaction* txPtr = manager->getTransactionPtrAt(i);
-                if (txPtr == nullptr) continue;
-                
-                bool matches = true;
-                
-                if (matches && !criteria.transactionType.empty()) {
-                    if (toLowercase(txPtr->transaction_type) != toLowercase(criteria.transactionType)) {
-                        matches = false;
-                    }
-                }
-                if (matches && !criteria.location.empty()) {
-                    if (toLowercase(txPtr->location).find(toLowercase(criteria.location)) == std::string::npos) {
-                        matches = false;
-                    }
-                }
-                if (matches && !criteria.paymentChannel.empty()) {
-                    if (toLowercase(txPtr->payment_channel) != toLowercase(criteria.paymentChannel)) {
-                        matches = false;
-                    }
-                }
-                if (matches && criteria.hasAmountRange) {
-                    if (txPtr->amount < criteria.minAmount || txPtr->amount > criteria.maxAmount) {
-                        matches = false;
-                    }
-                }
-                if (matches && criteria.isFraudOnly) {
-                    if (!txPtr->is_fraud) {
-                        matches = false;
-                    }
-                }
-                
-                if (matches) {
-                    found = true;
-                    matchCount++;
-                    
-                    resultsToSave.addTransaction(*txPtr);
-
-                    if (resultsToSave.getSize() <= MAX_DISPLAY) {
-                        std::cout << Color::GREEN << "  [" << matchCount << "]" << Color::RESET 
-                                  << " ID: " << Color::YELLOW << txPtr->transaction_id << Color::RESET
-                                  << " | Type: " << Color::BRIGHT_CYAN << txPtr->transaction_type << Color::RESET
-                                  << " | Amount: " << Color::BRIGHT_GREEN << "$" << txPtr->amount << Color::RESET
-                                  << " | Location: " << Color::MAGENTA << txPtr->location << Color::RESET
-                                  << " | Channel: " << Color::BLUE << txPtr->payment_channel << Color::RESET
-                                  << " | Fraud: " << (txPtr->is_fraud ? Color::RED + "YES" : Color::GREEN + "NO") << Color::RESET
-                                  << std::endl;
-                    }
-                    
-                    if (matchCount > 0 && matchCount % 5000 == 0) {
-                        std::cout << Color::YELLOW << "  ... found " << matchCount << " matches so far ..." << Color::RESET << "\n";
-                    }
-                }
-            } catch (const std::exception& e) {
-                std::cerr << Color::RED << "Error accessing transaction: " << e.what() << Color::RESET << std::endl;
-                break;
-            }
+        // Matches come out in sorted order when a sort left the array a view.
+        if (manager->transactionsArrayView.isActive()) {
+            matchCount = collectMatches(manager->transactionsArrayView, resolved, resultsToSave, MAX_DISPLAY);
+        } else {
+            matchCount = collectMatches(manager->transactionsArray, resolved, resultsToSave, MAX_DISPLAY);
         }
-        
-    } else {
-        std::cout << Color::BLUE << "📊 Using LinkedList for BOTH search AND result storage" << Color::RESET << "\n";
-        
-        TransactionLinkedList searchResults;
-        
-        for (int i = 0; i < manager->getTransactionCount(); ++i) {
-            try {
-                Transaction* txPtr = manager->getTransactionPtrAt(i);
-                if (txPtr == nullptr) continue;
-                
-                bool matches = true;
-                
-                if (matches && !criteria.transactionType.empty()) {
-                    if (toLowercase(txPtr->transaction_type) != toLowercase(criteria.transactionType)) {
-                        matches = false;
-                    }
-                }
-                if (matches && !criteria.location.empty()) {
-                    if (toLowercase(txPtr->location).find(toLowercase(criteria.location)) == std::string::npos) {
-                        matches = false;
-                    }
-                }
-                if (matches && !criteria.paymentChannel.empty()) {
-                    if (toLowercase(txPtr->payment_channel) != toLowercase(criteria.paymentChannel)) {
-                        matches = false;
-                    }
-                }
-                if (matches && criteria.hasAmountRange) {
-                    if (txPtr->amount < criteria.minAmount || txPtr->amount > criteria.maxAmount) {
-                        matches = false;
-                    }
-                }
-                if (matches && criteria.isFraudOnly) {
-                    if (!txPtr->is_fraud) {
-                        matches = false;
-                    }
-                }
-                
-                if (matches) {
-                    found = true;
-                    matchCount++;
-                    
-                    searchResults.addTransaction(*txPtr);
-
-                    if (searchResults.getSize() <= MAX_DISPLAY) {
-                        std::cout << Color::GREEN << "  [" << matchCount << "]" << Color::RESET 
-                                  << " ID: " << Color::YELLOW << txPtr->transaction_id << Color::RESET
-                                  << " | Type: " << Color::BRIGHT_CYAN << txPtr->transaction_type << Color::RESET
-                                  << " | Amount: " << Color::BRIGHT_GREEN << "$" << txPtr->amount << Color::RESET
-                                  << " | Location: " << Color::MAGENTA << txPtr->location << Color::RESET
-                                  << " | Channel: " << Color::BLUE << txPtr->payment_channel << Color::RESET
-                                  << " | Fraud: " << (txPtr->is_fraud ? Color::RED + "YES" : Color::GREEN + "NO") << Color::RESET
-                                  << std::endl;
-                    }
-                    
-                    if (matchCount > 0 && matchCount % 5000 == 0) {
-                        std::cout << Color::YELLOW << "  ... found " << matchCount << " matches so far ..." << Color::RESET << "\n";
-                    }
-                }
-            } catch (const std::exception& e) {
-                std::cerr << Color::RED << "Error accessing transaction: " << e.what() << Color::RESET << std::endl;
-                break;
+
+    } else if (manager->isUsingColumns()) {
+        std::cout << Color::MAGENTA << "📊 Using Columnar Store for BOTH search AND result storage" << Color::RESET << "\n";
+
+        const TransactionStore& columns = manager->transactionsColumns;
+        TransactionStore searchResults;
+
+        for (int r = 0; r < columns.getSize(); ++r) {
+            if (!matchesCriteria(columns, r, resolved)) continue;
+            matchCount++;
+
+            Transaction tx = columns.getTransaction(r);
+            TransactionTextView text = columns.getText(r);
+            searchResults.addTransaction(tx, text);
+
+            if (searchResults.getSize() <= MAX_DISPLAY) {
+                printSearchMatch(matchCount, tx, text);
             }
-        }
-        
-        if (found) {
-             for (int i = 0; i < searchResults.getSize(); ++i) {
-                Transaction* tx = searchResults.getTransaction(i);
-                if (tx) {
-                    resultsToSave.addTransaction(*tx);
-                }
+
+            if (matchCount > 0 && matchCount % 5000 == 0) {
+                std::cout << Color::YELLOW << "  ... found " << matchCount << " matches so far ..." << Color::RESET << "\n";
             }
         }
+
+        for (int i = 0; i < searchResults.getSize(); ++i) {
+            resultsToSave.addTransaction(searchResults.getTransaction(i), searchResults.getText(i));
+        }
+
+    } else if (manager->isUsingUnrolledList()) {
+        std::cout << Color::CYAN << "📊 Using Unrolled LinkedList for BOTH search AND result storage" << Color::RESET << "\n";
+
+        TransactionUnrolledList searchResults(manager->transactionsUnrolled.getTextStorage());
+        matchCount = collectMatches(manager->transactionsUnrolled, resolved, searchResults, MAX_DISPLAY);
+        copyRows(searchResults, resultsToSave);
+
+    } else {
+        std::cout << Color::BLUE << "📊 Using LinkedList for BOTH search AND result storage" << Color::RESET << "\n";
+
+        TransactionLinkedList searchResults(manager->transactionsLinkedList.getTextStorage());
+        matchCount = collectMatches(manager->transactionsLinkedList, resolved, searchResults, MAX_DISPLAY);
+        copyRows(searchResults, resultsToSave);
     }
+    found = matchCount > 0;
 
     auto endTime = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
@@ -274,7 +421,9 @@ void performUnifiedTrueSearch(TransactionManager* manager, const SearchCriteria&
                   << Color::RESET << " KB (current total: " << Color::YELLOW << memoryAfter << Color::RESET << " KB)\n";
         
         std::cout << Color::BLUE << "[STRUCTURE]" << Color::RESET 
-                  << " Used " << (manager->isUsingArray() ? Color::GREEN + "Array" : Color::BLUE + "LinkedList") 
+                  << " Used " << (manager->isUsingArray() ? Color::GREEN + "Array"
+                                  : manager->isUsingColumns() ? Color::MAGENTA + "Columnar"
+                                  : manager->isUsingUnrolledList() ? Color::CYAN + "Unrolled LinkedList" : Color::BLUE + "LinkedList")
                   << Color::RESET << " for both search AND result storage\n";
         
         std::cout << Color::BRIGHT_YELLOW << "[TRUE COMPARISON]" << Color::RESET 
@@ -305,14 +454,14 @@ void performUnifiedTrueSearch(TransactionManager* manager, const SearchCriteria&
 
         if (saveChoice == 'y' || saveChoice == 'Y') {
             try {
-                std::string origin_suffix = manager->isUsingArray() ? "_array.json" : "_linkedlist.json";
+                std::string origin_suffix = "_" + manager->getActiveStructureTag() + ".json";
                 std::string filename = generateUniqueFilename() + origin_suffix;
                 std::string filepath = "results/" + filename;
 
                 std::cout << Color::CYAN << "\n[SAVING]" << Color::RESET 
                           << " Saving results to " << Color::YELLOW << filepath << Color::RESET << "..." << std::endl;
                 
-                saveTransactionsToJson(resultsToSave, filepath);
+                saveTransactionsToJson(resultsToSave, filepath, manager->getLoadedColumns());
                 
                 std::cout << Color::BRIGHT_GREEN << "[SUCCESS]" << Color::RESET 
                           << " Results saved!" << Color::RESET << "\n";
@@ -329,25 +478,39 @@ void performUnifiedTrueSearch(TransactionManager* manager, const SearchCriteria&
 // Performance comparison between structures for any search type
 void performFullStructureComparison(TransactionManager* manager, const SearchCriteria& criteria, const std::string& searchTitle) {
     std::cout << "\n" << Color::BRIGHT_YELLOW << "⚡ FULL STRUCTURE COMPARISON ⚡" << Color::RESET << "\n";
-    std::cout << Color::CYAN << "Testing: " << searchTitle << " on both structures" << Color::RESET << "\n\n";
+    std::cout << Color::CYAN << "Testing: " << searchTitle << " on all four structures" << Color::RESET << "\n\n";
     
     // Store original structure
-    bool originalStructure = manager->isUsingArray();
+    DataStructureType originalStructure = manager->getActiveStructure();
     
     // Test Array Structure
     std::cout << Color::GREEN << "🔵 TESTING ARRAY STRUCTURE:" << Color::RESET << "\n";
-    manager->setActiveDataStructure(true);
+    manager->setActiveDataStructure(DataStructureType::ARRAY);
     auto arrayStart = std::chrono::high_resolution_clock::now();
     performUnifiedTrueSearch(manager, criteria, searchTitle + " (ARRAY)");
     auto arrayEnd = std::chrono::high_resolution_clock::now();
     auto arrayDuration = std::chrono::duration_cast<std::chrono::milliseconds>(arrayEnd - arrayStart);
     
     std::cout << "\n" << Color::BLUE << "🔵 TESTING LINKEDLIST STRUCTURE:" << Color::RESET << "\n";
-    manager->setActiveDataStructure(false);
+    manager->setActiveDataStructure(DataStructureType::LINKED_LIST);
     auto listStart = std::chrono::high_resolution_clock::now();
     performUnifiedTrueSearch(manager, criteria, searchTitle + " (LINKEDLIST)");
     auto listEnd = std::chrono::high_resolution_clock::now();
     auto listDuration = std::chrono::duration_cast<std::chrono::milliseconds>(listEnd - listStart);
+
+    std::cout << "\n" << Color::MAGENTA << "🔵 TESTING COLUMNAR STRUCTURE:" << Color::RESET << "\n";
+    manager->setActiveDataStructure(DataStructureType::COLUMNAR);
+    auto columnsStart = std::chrono::high_resolution_clock::now();
+    performUnifiedTrueSearch(manager, criteria, searchTitle + " (COLUMNAR)");
+    auto columnsEnd = std::chrono::high_resolution_clock::now();
+    auto columnsDuration = std::chrono::duration_cast<std::chrono::milliseconds>(columnsEnd - columnsStart);
+
+    std::cout << "\n" << Color::CYAN << "🔵 TESTING UNROLLED LINKEDLIST STRUCTURE:" << Color::RESET << "\n";
+    manager->setActiveDataStructure(DataStructureType::UNROLLED_LIST);
+    auto unrolledStart = std::chrono::high_resolution_clock::now();
+    performUnifiedTrueSearch(manager, criteria, searchTitle + " (UNROLLED)");
+    auto unrolledEnd = std::chrono::high_resolution_clock::now();
+    auto unrolledDuration = std::chrono::duration_cast<std::chrono::milliseconds>(unrolledEnd - unrolledStart);
     
     // Restore original structure
     manager->setActiveDataStructure(originalStructure);
@@ -360,18 +523,29 @@ void performFullStructureComparison(TransactionManager* manager, const SearchCri
               << std::right << std::setw(15) << arrayDuration.count() << " ms" << "\n";
     std::cout << std::left << std::setw(25) << Color::BLUE + "LinkedList Structure:" + Color::RESET
               << std::right << std::setw(15) << listDuration.count() << " ms" << "\n";
+    std::cout << std::left << std::setw(25) << Color::MAGENTA + "Columnar Structure:" + Color::RESET
+              << std::right << std::setw(15) << columnsDuration.count() << " ms" << "\n";
+    std::cout << std::left << std::setw(25) << Color::CYAN + "Unrolled Structure:" + Color::RESET
+              << std::right << std::setw(15) << unrolledDuration.count() << " ms" << "\n";
     
     std::cout << std::string(60, '-') << "\n";
     
-    if (arrayDuration.count() > 0 && listDuration.count() > 0) {
-        if (arrayDuration < listDuration) {
-            double speedup = (double)listDuration.count() / arrayDuration.count();
+    if (arrayDuration.count() > 0 && listDuration.count() > 0 && columnsDuration.count() > 0 && unrolledDuration.count() > 0) {
+        auto fastest = std::min({arrayDuration, listDuration, columnsDuration, unrolledDuration});
+        auto slowest = std::max({arrayDuration, listDuration, columnsDuration, unrolledDuration});
+        double speedup = (double)slowest.count() / fastest.count();
+        if (fastest == arrayDuration) {
             std::cout << Color::BRIGHT_GREEN << "🏆 Array is " << std::fixed << std::setprecision(2) 
-                      << speedup << "x faster for " << searchTitle << Color::RESET << "\n";
-        } else {
-            double speedup = (double)arrayDuration.count() / listDuration.count();
+                      << speedup << "x faster than the slowest for " << searchTitle << Color::RESET << "\n";
+        } else if (fastest == listDuration) {
             std::cout << Color::BRIGHT_BLUE << "🏆 LinkedList is " << std::fixed << std::setprecision(2) 
-                      << speedup << "x faster for " << searchTitle << Color::RESET << "\n";
+                      << speedup << "x faster than the slowest for " << searchTitle << Color::RESET << "\n";
+        } else if (fastest == unrolledDuration) {
+            std::cout << Color::BRIGHT_CYAN << "🏆 Unrolled LinkedList is " << std::fixed << std::setprecision(2) 
+                      << speedup << "x faster than the slowest for " << searchTitle << Color::RESET << "\n";
+        } else {
+            std::cout << Color::BRIGHT_MAGENTA << "🏆 Columnar is " << std::fixed << std::setprecision(2) 
+                      << speedup << "x faster than the slowest for " << searchTitle << Color::RESET << "\n";
         }
     }
     
@@ -394,13 +568,14 @@ void TransactionManager::searchTransactions() {
         std::cout << Color::WHITE << " 6. Performance Test (Current Structure)" << Color::RESET << "\n"; 
         std::cout << Color::BRIGHT_MAGENTA << " 7. Switch Active Data Structure" << Color::RESET << "\n";
         std::cout << Color::BRIGHT_YELLOW << " 8. Compare Structures (Any Search)" << Color::RESET << "\n";
+        std::cout << Color::BRIGHT_CYAN << " 9. Compare Record Layouts (Scan Benchmark)" << Color::RESET << "\n";
         std::cout << Color::RED << " 0. Return to Main Menu" << Color::RESET << "\n";
         std::cout << Color::BOLD << Color::CYAN << "==========================================" << Color::RESET << "\n";
         
         std::cout << Color::YELLOW << "Current Active Structure: " << this->getCurrentDataStructureName() << Color::RESET << "\n";
         
         int choice;
-        std::cout << "Enter your choice (0-8): ";
+        std::cout << "Enter your choice (0-9): ";
         std::cin >> choice;
 
         if(std::cin.fail()) {
@@ -543,6 +718,11 @@ void TransactionManager::searchTransactions() {
                 break;
             }
             
+            case 9: {
+                this->compareRecordLayouts();
+                break;
+            }
+            
             default:
                 std::cout << Color::RED << "Invalid choice! Please try again." << Color::RESET << "\n";
         }
@@ -1,7 +1,6 @@
 #include "transaction_manager.h"
 #include "custom_data_structures.h"
 #include <iostream>
-#include <functional>
 #include <limits>
 #include <chrono>
 #include <iomanip>
@@ -11,30 +10,12 @@
 #include <cstdio>
 #include <cstring>
 #include <cstdlib>
+#include <unistd.h>
+#include "fast_csv_reader.h"
+#include "parallel_csv_parser.h"
+#include "transaction_fields.h"
+#include "sort_algorithms.h"
 
-static long getMemoryUsageKB() {
-    long rss = 0L;
-    FILE* fp = fopen("/proc/self/status", "r");
-    if (fp != NULL) {
-        char line[128];
-        while (fgets(line, 128, fp) != NULL) {
-            if (strncmp(line, "VmRSS:", 6) == 0) {
-                char* p = line;
-                while (*p && !isdigit(*p)) p++;
-                rss = atol(p);
-                break;
-            }
-        }
-        fclose(fp);
-    }
-    return rss;
-}
-
-enum class SortField {
-    LOCATION,
-    AMOUNT,
-    TIMESTAMP
-};
 
 std::string getFieldName(SortField field) {
     switch (field) {
@@ -45,181 +26,224 @@ std::string getFieldName(SortField field) {
     }
 }
 
-void quickSortArray(Transaction* arr, int left, int right, std::function<bool(const Transaction&, const Transaction&)> comp) {
-    if (left >= right) return;
-    Transaction pivot = arr[(left + right) / 2];
-    int i = left, j = right;
-    while (i <= j) {
-        while (comp(arr[i], pivot)) i++;
-        while (comp(pivot, arr[j])) j--;
-        if (i <= j) {
-            std::swap(arr[i], arr[j]);
-            i++; j--;
-        }
-    }
-    quickSortArray(arr, left, j, comp);
-    quickSortArray(arr, i, right, comp);
+// The sort key plus the ID shown next to it in the sorted listing.
+static CsvColumnSet columnsForSort(SortField field) {
+    CsvColumnSet key = field == SortField::AMOUNT ? csvColumnBit(CSV_AMOUNT)
+                     : field == SortField::TIMESTAMP ? csvColumnBit(CSV_TIMESTAMP)
+                     : csvColumnBit(CSV_LOCATION);
+    return key | csvColumnBit(CSV_TRANSACTION_ID);
 }
 
-void merge(Transaction* arr, int left, int mid, int right, std::function<bool(const Transaction&, const Transaction&)> comp) {
-    int n1 = mid - left + 1;
-    int n2 = right - mid;
-    Transaction* L = new Transaction[n1];
-    Transaction* R = new Transaction[n2];
-    for (int i = 0; i < n1; ++i) L[i] = arr[left + i];
-    for (int j = 0; j < n2; ++j) R[j] = arr[mid + 1 + j];
-    int i = 0, j = 0, k = left;
-    while (i < n1 && j < n2) arr[k++] = comp(L[i], R[j]) ? L[i++] : R[j++];
-    while (i < n1) arr[k++] = L[i++];
-    while (j < n2) arr[k++] = R[j++];
-    delete[] L;
-    delete[] R;
+static const char* sortAlgorithmName(int algoChoice) {
+    return algoChoice == 1 ? "QuickSort" : algoChoice == 2 ? "MergeSort" : "RadixSort";
 }
 
-void mergeSortArray(Transaction* arr, int left, int right, std::function<bool(const Transaction&, const Transaction&)> comp) {
-    if (left >= right) return;
-    int mid = left + (right - left) / 2;
-    mergeSortArray(arr, left, mid, comp);
-    mergeSortArray(arr, mid + 1, right, comp);
-    merge(arr, left, mid, right, comp);
+// For result file names.
+static const char* sortAlgorithmTag(int algoChoice) {
+    return algoChoice == 1 ? "quick" : algoChoice == 2 ? "merge" : "radix";
 }
 
-TransactionNode* mergeSortedLists(TransactionNode* a, TransactionNode* b, 
-    std::function<bool(const Transaction&, const Transaction&)> comp) {
-    
-    if (!a) return b;
-    if (!b) return a;
-    
-    TransactionNode* result = nullptr;
-    TransactionNode* tail = nullptr;
-    
-    while (a && b) {
-        if (comp(a->data, b->data)) {
-            if (!result) {
-                result = tail = a;
-            } else {
-                tail->next = a;
-                tail = a;
-            }
-            a = a->next;
-        } else {
-            if (!result) {
-                result = tail = b;
-            } else {
-                tail->next = b;
-                tail = b;
-            }
-            b = b->next;
+// algoChoice is 1 for quick sort, 2 for merge sort and 3 for radix sort in
+// the helpers below. Without ranks (streaming, where later batches may add
+// locations) the comparison sorts compare location names instead; the
+// radix sort always needs them.
+static void sortRecords(Transaction* rows, int size, SortField field, int algoChoice, const CategoryRanks* locationRanks) {
+    if (algoChoice == 3) {
+        uint64_t* keys = new uint64_t[size];
+        int* order = new int[size];
+        fillSortKeys(rows, rows + size, field, *locationRanks, keys);
+        radixSortOrder(keys, size, order);
+        applyOrder(rows, order, size);
+        delete[] order;
+        delete[] keys;
+        return;
+    }
+    withTransactionLess(field, locationRanks, [&](const auto& comparator) {
+        if (algoChoice == 1)
+            quickSortArray(rows, 0, size - 1, comparator);
+        else
+            mergeSortArray(rows, 0, size - 1, comparator);
+    });
+}
+
+// Index sort of the array: the records stay where they are while (key, row)
+// pairs are sorted, and the result is either kept as the manager's array
+// view or applied to the records once (ArraySortMode::REORDER). Sorting
+// again while a view is active sorts the rows in the view's order, so ties
+// keep it, as a stable sort of the reordered records would.
+static void sortArrayRows(TransactionManager* manager, SortField field, int algoChoice, const CategoryRanks& locationRanks) {
+    TransactionArray& array = manager->transactionsArray;
+    TransactionArrayView& view = manager->transactionsArrayView;
+    const int size = array.getSize();
+    uint64_t* keys = new uint64_t[size];
+    int* order = new int[size];
+    if (view.isActive()) {
+        fillSortKeys(view.begin(), view.end(), field, locationRanks, keys);
+    } else {
+        fillSortKeys(array.begin(), array.end(), field, locationRanks, keys);
+    }
+    sortKeyOrder(keys, size, algoChoice, order, resolveThreadCount(manager->getSortThreadCount()));
+    delete[] keys;
+    if (view.isActive()) {
+        const int* previous = view.getRows();
+        for (int i = 0; i < size; ++i) {
+            order[i] = previous[order[i]];
         }
     }
-    
-    if (tail) {
-        tail->next = a ? a : b;
+    if (manager->getArraySortMode() == ArraySortMode::REORDER) {
+        view = TransactionArrayView();
+        applyOrder(array.getDataPointer(), order, size);
+        delete[] order;
     } else {
-        result = a ? a : b;
+        view = TransactionArrayView(array, order);
     }
-    
-    return result;
 }
 
-void splitList(TransactionNode* source, TransactionNode** front, TransactionNode** back) {
-    TransactionNode* slow = source;
-    TransactionNode* fast = source->next;
-    while (fast) {
-        fast = fast->next;
-        if (fast) {
-            slow = slow->next;
-            fast = fast->next;
+// Times the parallel merge sort of the same (key, row) entries on 1, 2, 4, ...
+// threads up to maxThreads and prints each time with its speedup over one
+// thread.
+static void printMergeSortScaling(const uint64_t* keys, int count, int maxThreads) {
+    SortEntry* input = new SortEntry[count];
+    SortEntry* entries = new SortEntry[count];
+    SortEntry* reference = new SortEntry[count];
+    for (int i = 0; i < count; ++i) {
+        input[i].key = keys[i];
+        input[i].row = i;
+    }
+
+    std::cout << "\n" << Color::BOLD << Color::BRIGHT_CYAN << "📈 Parallel MergeSort Scaling (Array, " << count
+              << " rows)" << Color::RESET << "\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::left << std::setw(12) << "Threads" << std::right << std::setw(15) << "Time (ms)"
+              << std::setw(15) << "Speedup" << "\n";
+    std::cout << std::string(60, '-') << "\n";
+    double singleMs = 0;
+    for (int threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+        std::copy(input, input + count, entries);
+        auto start = std::chrono::high_resolution_clock::now();
+        parallelMergeSortArray(entries, count, SortEntryLess(), threads);
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        bool sameOrder = true;
+        if (threads == 1) {
+            singleMs = ms;
+            std::copy(entries, entries + count, reference);
+        } else {
+            for (int i = 0; i < count && sameOrder; ++i) {
+                sameOrder = entries[i].row == reference[i].row;
+            }
         }
+        std::cout << std::left << std::setw(12) << threads << std::right << std::setw(15) << ms << std::setw(14)
+                  << (ms > 0 ? singleMs / ms : 0.0) << "x"
+                  << (sameOrder ? "" : Color::RED + "  order differs!" + Color::RESET) << "\n";
+        if (threads >= maxThreads) break;
     }
-    *front = source;
-    *back = slow->next;
-    slow->next = nullptr;
+    std::cout << std::string(60, '=') << "\n";
+    delete[] reference;
+    delete[] entries;
+    delete[] input;
 }
 
-TransactionNode* mergeSortLinkedList(TransactionNode* head, std::function<bool(const Transaction&, const Transaction&)> comp) {
-    if (!head || !head->next) return head;
-    TransactionNode* a;
-    TransactionNode* b;
-    splitList(head, &a, &b);
-    a = mergeSortLinkedList(a, comp);
-    b = mergeSortLinkedList(b, comp);
-    return mergeSortedLists(a, b, comp);
+// The nodes are put in key order through an array of node pointers and
+// relinked; the records stay where they are.
+static void radixSortList(TransactionLinkedList& list, SortField field, const CategoryRanks& locationRanks) {
+    const int size = list.getSize();
+    TransactionNode** nodes = new TransactionNode*[size];
+    uint64_t* keys = new uint64_t[size];
+    int* order = new int[size];
+    int k = 0;
+    for (TransactionNode* node = list.getHead(); node; node = node->next) {
+        nodes[k++] = node;
+    }
+    fillSortKeys(list.begin(), list.end(), field, locationRanks, keys);
+    radixSortOrder(keys, size, order);
+    applyOrder(nodes, order, size);
+    list.relink(nodes);
+    delete[] order;
+    delete[] keys;
+    delete[] nodes;
 }
 
-TransactionNode* mergeSortLinkedListIterative(TransactionNode* head, 
-    std::function<bool(const Transaction&, const Transaction&)> comp) {
-    
-    if (!head || !head->next) return head;
-    
-    int length = 0;
-    TransactionNode* current = head;
-    while (current) {
-        length++;
-        current = current->next;
+static void sortColumnStore(TransactionStore& store, SortField field, int algoChoice, const CategoryRanks* locationRanks) {
+    const int size = store.getSize();
+    const uint16_t* locations = store.getLocations();
+    const double* amounts = store.getAmounts();
+    const int64_t* timestamps = store.getTimestamps();
+
+    int* order = new int[size];
+    if (algoChoice == 3) {
+        uint64_t* keys = new uint64_t[size];
+        for (int i = 0; i < size; ++i) {
+            keys[i] = field == SortField::AMOUNT ? radixKey(amounts[i])
+                    : field == SortField::TIMESTAMP ? radixKey(timestamps[i])
+                    : (*locationRanks)[locations[i]];
+        }
+        radixSortOrder(keys, size, order);
+        delete[] keys;
+        store.reorder(order);
+        delete[] order;
+        return;
     }
-    
-    for (int size = 1; size < length; size *= 2) {
-        TransactionNode* newHead = nullptr;
-        TransactionNode* tail = nullptr;
-        TransactionNode* curr = head;
-        
-        while (curr) {
-            TransactionNode* first = curr;
-            int firstSize = 0;
-            
-            while (curr && firstSize < size - 1) {
-                curr = curr->next;
-                firstSize++;
-            }
-            
-            if (!curr || !curr->next) {
-                if (!newHead) {
-                    newHead = first;
-                } else {
-                    tail->next = first;
-                }
-                break;
-            }
-            
-            TransactionNode* secondStart = curr->next;
-            curr->next = nullptr;
-            curr = secondStart;
-            
-            TransactionNode* second = secondStart;
-            int secondSize = 0;
-            
-            while (curr && secondSize < size - 1) {
-                curr = curr->next;
-                secondSize++;
-            }
-            
-            TransactionNode* nextStart = nullptr;
-            if (curr) {
-                nextStart = curr->next;
-                curr->next = nullptr;
-            }
-            
-            TransactionNode* merged = mergeSortedLists(first, second, comp);
-            
-            if (!newHead) {
-                newHead = merged;
+    for (int i = 0; i < size; ++i) order[i] = i;
+    auto sortOrder = [&](const auto& comp) {
+        if (algoChoice == 1) {
+            quickSortIndices(order, 0, size - 1, comp);
+        } else {
+            int* scratch = new int[size];
+            mergeSortIndices(order, scratch, 0, size - 1, comp);
+            delete[] scratch;
+        }
+    };
+    switch (field) {
+        case SortField::AMOUNT:
+            sortOrder([amounts](int a, int b) { return amounts[a] < amounts[b]; });
+            break;
+        case SortField::TIMESTAMP:
+            sortOrder([timestamps](int a, int b) { return timestamps[a] < timestamps[b]; });
+            break;
+        default:
+            if (locationRanks) {
+                sortOrder([locations, locationRanks](int a, int b) {
+                    return (*locationRanks)[locations[a]] < (*locationRanks)[locations[b]];
+                });
             } else {
-                tail->next = merged;
-            }
-            
-            tail = merged;
-            while (tail->next) {
-                tail = tail->next;
+                sortOrder([locations](int a, int b) {
+                    return categoryName(CATEGORY_LOCATION, locations[a]) < categoryName(CATEGORY_LOCATION, locations[b]);
+                });
             }
-            
-            curr = nextStart;
-        }
-        
-        head = newHead;
+            break;
     }
-    
-    return head;
+    store.reorder(order);
+    delete[] order;
+}
+
+// The unrolled list is sorted through a flat copy of its records, which are
+// then written back block by block, so every block keeps its fill.
+static void sortUnrolledList(TransactionUnrolledList& list, SortField field, int algoChoice, const CategoryRanks* locationRanks) {
+    const int size = list.getSize();
+    Transaction* rows = new Transaction[size];
+    int k = 0;
+    for (TransactionBlock* block = list.getHead(); block; block = block->next) {
+        std::copy(block->rows, block->rows + block->count, rows + k);
+        k += block->count;
+    }
+    sortRecords(rows, size, field, algoChoice, locationRanks);
+    k = 0;
+    for (TransactionBlock* block = list.getHead(); block; block = block->next) {
+        std::copy(rows + k, rows + k + block->count, block->rows);
+        k += block->count;
+    }
+    delete[] rows;
+}
+
+// The rows of a list, in list order, for the array-based JSON writer.
+template <typename List>
+static TransactionArray copyToArray(const List& list) {
+    TransactionArray rows(list.getSize(), list.getTextStorage());
+    for (const Transaction& tx : list) {
+        rows.addTransaction(tx, list.getText(tx));
+    }
+    return rows;
 }
 
 void saveSortedResultsToJson(TransactionManager* manager, SortField field, const std::string& algoName) {
@@ -228,26 +252,216 @@ void saveSortedResultsToJson(TransactionManager* manager, SortField field, const
     std::stringstream ss;
     ss << "sorted_" << getFieldName(field) << "_" << algoName << "_";
     ss << std::put_time(std::localtime(&in_time_t), "%Y%m%d_%H%M%S");
-    ss << (manager->isUsingArray() ? "_array.json" : "_linkedlist.json");
+    ss << "_" << manager->getActiveStructureTag() << ".json";
     
     std::string filename = ss.str();
     std::string filepath = "results/" + filename;
     
     std::cout << Color::CYAN << "💾 Saving sorted results to " << Color::YELLOW << filepath << Color::RESET << "...\n";
     
-    if (manager->isUsingArray()) {
-        saveTransactionsToJson(manager->transactionsArray, filepath);
+    if (manager->isUsingArray() && manager->transactionsArrayView.isActive()) {
+        saveTransactionsToJson(manager->transactionsArrayView, filepath, manager->getLoadedColumns());
+    } else if (manager->isUsingArray()) {
+        saveTransactionsToJson(manager->transactionsArray, filepath, manager->getLoadedColumns());
+    } else if (manager->isUsingColumns()) {
+        saveTransactionsToJson(manager->transactionsColumns, filepath, manager->getLoadedColumns());
+    } else if (manager->isUsingUnrolledList()) {
+        saveTransactionsToJson(copyToArray(manager->transactionsUnrolled), filepath, manager->getLoadedColumns());
     } else {
-        TransactionArray temp;
-        for (int i = 0; i < manager->transactionsLinkedList.getSize(); ++i) {
-            Transaction* tx = manager->transactionsLinkedList.getTransaction(i);
-            if (tx) temp.addTransaction(*tx);
-        }
-        saveTransactionsToJson(temp, filepath);
+        saveTransactionsToJson(copyToArray(manager->transactionsLinkedList), filepath, manager->getLoadedColumns());
     }
     std::cout << Color::BRIGHT_GREEN << "✅ Saved successfully!" << Color::RESET << "\n";
 }
 
+static void printSortedRow(int index, const Transaction& tx, const TransactionTextView& text, SortField field) {
+    std::cout << Color::GREEN << "[" << index+1 << "] " << Color::RESET;
+    switch (field) {
+        case SortField::LOCATION:
+            std::cout << "Location: " << Color::YELLOW << categoryName(CATEGORY_LOCATION, tx.location) << Color::RESET
+                      << " | ID: " << text.transaction_id << "\n";
+            break;
+        case SortField::AMOUNT:
+            std::cout << "Amount: " << Color::YELLOW << "$" << tx.amount << Color::RESET
+                      << " | ID: " << text.transaction_id << "\n";
+            break;
+        case SortField::TIMESTAMP:
+            std::cout << "Timestamp: " << Color::YELLOW << timestampToString(tx.timestamp) << Color::RESET
+                      << " | ID: " << text.transaction_id << "\n";
+            break;
+    }
+}
+
+template <typename Rows>
+static void printFirstSortedRows(const Rows& rows, SortField field) {
+    int index = 0;
+    for (auto it = rows.begin(); it != rows.end() && index < 10; ++it, ++index) {
+        printSortedRow(index, *it, rows.getText(*it), field);
+    }
+}
+
+static std::string sortRunPath(int index) {
+    return "results/.sort_run_" + std::to_string(getpid()) + "_" + std::to_string(index) + ".csv";
+}
+
+// Streaming mode external sort: each batch is sorted in the active structure
+// and spilled to a run file, then the runs are k-way merged straight into the
+// output JSON. Ties go to the earlier run.
+template <typename Compare>
+static void performStreamingSort(TransactionManager* manager, SortField field, int algoChoice, const Compare& comparator) {
+    auto now = std::chrono::system_clock::now();
+    auto in_time_t = std::chrono::system_clock::to_time_t(now);
+    std::stringstream ss;
+    ss << "results/sorted_" << getFieldName(field) << "_" << sortAlgorithmTag(algoChoice) << "_";
+    ss << std::put_time(std::localtime(&in_time_t), "%Y%m%d_%H%M%S");
+    ss << "_stream_" << manager->getActiveStructureTag() << ".json";
+    std::string filepath = ss.str();
+
+    std::cout << "\n" << Color::BRIGHT_YELLOW << "🔍 Streaming sort by " << getFieldName(field)
+              << " in batches of " << manager->getStreamBatchRows() << " rows on "
+              << manager->getCurrentDataStructureName() << "..." << Color::RESET << "\n";
+
+    resetPeakMemoryUsage();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    int runCount = 0;
+    bool runFailed = false;
+    bool completed = manager->forEachStreamBatch([&](TransactionArray& batch) {
+        std::string runPath = sortRunPath(runCount);
+        FILE* fp = std::fopen(runPath.c_str(), "wb");
+        if (!fp) {
+            std::perror(("Error opening " + runPath).c_str());
+            runFailed = true;
+            return false;
+        }
+        runCount++;
+        writeTransactionCsvHeader(fp);
+        // Every location in the batch has a code by now, so a rank table
+        // built here covers the radix keys.
+        CategoryRanks batchRanks(CATEGORY_LOCATION);
+        const CategoryRanks* radixRanks = algoChoice == 3 ? &batchRanks : nullptr;
+
+        if (manager->isUsingArray()) {
+            sortRecords(batch.getDataPointer(), batch.getSize(), field, algoChoice, radixRanks);
+            for (int i = 0; i < batch.getSize(); ++i) {
+                const Transaction& tx = *batch.getTransaction(i);
+                writeTransactionCsvRow(fp, tx, batch.getText(tx));
+            }
+        } else if (manager->isUsingColumns()) {
+            TransactionStore columns(batch.getSize());
+            for (int i = 0; i < batch.getSize(); ++i) {
+                const Transaction& tx = *batch.getTransaction(i);
+                columns.addTransaction(tx, batch.getText(tx));
+            }
+            sortColumnStore(columns, field, algoChoice, radixRanks);
+            for (int i = 0; i < columns.getSize(); ++i) {
+                writeTransactionCsvRow(fp, columns.getTransaction(i), columns.getText(i));
+            }
+        } else if (manager->isUsingUnrolledList()) {
+            TransactionUnrolledList list;
+            for (int i = 0; i < batch.getSize(); ++i) {
+                const Transaction& tx = *batch.getTransaction(i);
+                list.addTransaction(tx, batch.getText(tx));
+            }
+            sortUnrolledList(list, field, algoChoice, radixRanks);
+            for (const Transaction& tx : list) {
+                writeTransactionCsvRow(fp, tx, list.getText(tx));
+            }
+        } else {
+            TransactionLinkedList list;
+            for (int i = 0; i < batch.getSize(); ++i) {
+                Transaction& tx = *batch.getTransaction(i);
+                list.addTransaction(tx, batch.getText(tx));
+            }
+            if (algoChoice == 3)
+                radixSortList(list, field, batchRanks);
+            else
+                list.adoptSortedChain(mergeSortLinkedListIterative(list.getHead(), comparator));
+            for (const Transaction& tx : list) {
+                writeTransactionCsvRow(fp, tx, list.getText(tx));
+            }
+        }
+        std::fclose(fp);
+        return true;
+    });
+
+    long written = 0;
+    if (completed && !runFailed) {
+        TransactionJsonWriter out;
+        MappedCsvFile* runFiles = new MappedCsvFile[runCount];
+        CsvColumnLayout* layouts = new CsvColumnLayout[runCount];
+        MappedCsvReader** readers = new MappedCsvReader*[runCount];
+        Transaction* heads = new Transaction[runCount];
+        TransactionText* headTexts = new TransactionText[runCount];
+        bool* alive = new bool[runCount];
+        CsvField fields[CSV_COLUMN_COUNT];
+
+        for (int r = 0; r < runCount; ++r) {
+            readers[r] = nullptr;
+            alive[r] = false;
+            const char* cursor = nullptr;
+            if (runFiles[r].open(sortRunPath(r))) {
+                cursor = runFiles[r].begin();
+                if (layouts[r].parseHeader(cursor, runFiles[r].end())) {
+                    readers[r] = new MappedCsvReader(cursor, runFiles[r].end(), layouts[r]);
+                    alive[r] = readers[r]->readRow(fields);
+                    if (alive[r]) fillTransactionFromFields(fields, heads[r], headTexts[r]);
+                }
+            }
+        }
+
+        std::cout << "\n" << Color::CYAN << "First 10 sorted results:" << Color::RESET << "\n";
+        std::cout << std::string(80, '-') << "\n";
+        if (out.open(filepath)) {
+            while (true) {
+                int best = -1;
+                for (int r = 0; r < runCount; ++r) {
+                    if (alive[r] && (best < 0 || comparator(heads[r], heads[best]))) best = r;
+                }
+                if (best < 0) break;
+
+                out.write(heads[best], headTexts[best]);
+                if (written < 10) printSortedRow(static_cast<int>(written), heads[best], headTexts[best], field);
+                written++;
+
+                alive[best] = readers[best]->readRow(fields);
+                if (alive[best]) fillTransactionFromFields(fields, heads[best], headTexts[best]);
+                if (written % 4096 == 0) {
+                    for (int r = 0; r < runCount; ++r) {
+                        if (readers[r]) releaseMappedRange(runFiles[r].begin(), readers[r]->getPosition());
+                    }
+                }
+            }
+            out.close();
+        }
+        std::cout << std::string(80, '-') << "\n";
+
+        for (int r = 0; r < runCount; ++r) {
+            delete readers[r];
+        }
+        delete[] alive;
+        delete[] headTexts;
+        delete[] heads;
+        delete[] readers;
+        delete[] layouts;
+        delete[] runFiles;
+    }
+    for (int r = 0; r < runCount; ++r) {
+        std::remove(sortRunPath(r).c_str());
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> duration = end - start;
+
+    std::cout << Color::GREEN << "⏱️  Time Taken: " << Color::YELLOW << duration.count() << " ms" << Color::RESET
+              << " (" << runCount << " sorted runs merged)\n";
+    std::cout << Color::BLUE << "💾 Peak RSS: " << Color::YELLOW << getPeakMemoryUsageKB()
+              << " KB (budget " << manager->getMemoryBudgetMB() * 1024 << " KB)" << Color::RESET << "\n";
+    if (written > 0) {
+        std::cout << Color::BRIGHT_GREEN << "✅ Sorted " << written << " transactions into " << Color::YELLOW
+                  << filepath << Color::RESET << "\n";
+    }
+}
+
 void performSort(TransactionManager* manager) {
     std::cout << "\n" << Color::CYAN << "Choose field to sort by:" << Color::RESET << "\n";
     std::cout << "1. Location\n";
@@ -277,8 +491,9 @@ void performSort(TransactionManager* manager) {
     std::cout << "\n" << Color::CYAN << "Choose sorting algorithm:" << Color::RESET << "\n";
     std::cout << "1. Quick Sort\n";
     std::cout << "2. Merge Sort\n";
+    std::cout << "3. Radix Sort (LSD)\n";
     std::cout << Color::RED << "0. Go Back" << Color::RESET << "\n";
-    std::cout << "Enter choice (0-2): ";
+    std::cout << "Enter choice (0-3): ";
     
     int algoChoice;
     std::cin >> algoChoice;
@@ -286,34 +501,53 @@ void performSort(TransactionManager* manager) {
     
     if (algoChoice == 0) return;
     
-    if (algoChoice < 1 || algoChoice > 2) {
+    if (algoChoice < 1 || algoChoice > 3) {
         std::cout << Color::RED << "Invalid choice!" << Color::RESET << "\n";
         return;
     }
 
-    auto comparator = [&](const Transaction& a, const Transaction& b) {
-        switch (field) {
-            case SortField::LOCATION: return a.location < b.location;
-            case SortField::AMOUNT: return a.amount < b.amount;
-            case SortField::TIMESTAMP: return a.timestamp < b.timestamp;
-            default: return false;
-        }
-    };
+    if (!manager->requireColumns(columnsForSort(field), "Sorting by " + getFieldName(field))) {
+        return;
+    }
+
+    // Locations compare by alphabetical rank of their codes. Later streaming
+    // batches may still add locations the table does not know, so streaming
+    // compares the names instead.
+    CategoryRanks locationRanks(CATEGORY_LOCATION);
+    if (manager->isStreaming()) {
+        withTransactionLess(field, nullptr, [&](const auto& comparator) {
+            performStreamingSort(manager, field, algoChoice, comparator);
+        });
+        return;
+    }
+
+    // The list may still be empty or building after a load.
+    if (manager->getActiveStructure() == DataStructureType::LINKED_LIST) {
+        manager->ensureLinkedList();
+    }
 
     std::cout << "\n" << Color::BRIGHT_YELLOW << "🔍 Sorting by " << getFieldName(field) 
-              << " using " << (algoChoice == 1 ? "QuickSort" : "MergeSort") 
+              << " using " << sortAlgorithmName(algoChoice)
+              << (manager->isUsingArray() && algoChoice == 2
+                      ? " (" + std::to_string(resolveThreadCount(manager->getSortThreadCount())) + " threads)" : "")
               << " on " << manager->getCurrentDataStructureName() << "..." << Color::RESET << "\n";
     
     long memoryBefore = getMemoryUsageKB();
     auto start = std::chrono::high_resolution_clock::now();
 
     if (manager->isUsingArray()) {
-        Transaction* arr = manager->transactionsArray.getDataPointer();
-        int size = manager->transactionsArray.getSize();
-        if (algoChoice == 1)
-            quickSortArray(arr, 0, size - 1, comparator);
-        else
-            mergeSortArray(arr, 0, size - 1, comparator);
+        manager->waitForBackgroundListBuild();
+        sortArrayRows(manager, field, algoChoice, locationRanks);
+        manager->markSorted(DataStructureType::ARRAY, field);
+    } else if (manager->isUsingColumns()) {
+        sortColumnStore(manager->transactionsColumns, field, algoChoice, &locationRanks);
+        manager->markSorted(DataStructureType::COLUMNAR, field);
+    } else if (manager->isUsingUnrolledList()) {
+        sortUnrolledList(manager->transactionsUnrolled, field, algoChoice, &locationRanks);
+        manager->markSorted(DataStructureType::UNROLLED_LIST, field);
+    } else if (algoChoice == 3) {
+        radixSortList(manager->transactionsLinkedList, field, locationRanks);
+        manager->markSorted(DataStructureType::LINKED_LIST, field);
     } else {
         TransactionNode* sorted = nullptr;
         
@@ -330,20 +564,20 @@ void performSort(TransactionManager* manager) {
         
         if (nodeCount >= 5000) {
             std::cout << Color::YELLOW << "Large dataset detected. Using iterative approach...\n" << Color::RESET;
-            sorted = mergeSortLinkedListIterative(
-                manager->transactionsLinkedList.getHead(), comparator);
-        } else {
-            sorted = mergeSortLinkedList(
-                manager->transactionsLinkedList.getHead(), comparator);
-        }
-        
-        TransactionLinkedList newList;
-        TransactionNode* current = sorted;
-        while (current) {
-            newList.addTransaction(current->data);
-            current = current->next;
         }
-        manager->transactionsLinkedList = newList;
+        withTransactionLess(field, &locationRanks, [&](const auto& comparator) {
+            if (nodeCount >= 5000) {
+                sorted = mergeSortLinkedListIterative(
+                    manager->transactionsLinkedList.getHead(), comparator);
+            } else {
+                sorted = mergeSortLinkedList(
+                    manager->transactionsLinkedList.getHead(), comparator);
+            }
+        });
+        // The sort relinked the list's own nodes; the list takes the chain
+        // as it is, with no copy of the rows.
+        manager->transactionsLinkedList.adoptSortedChain(sorted);
+        manager->markSorted(DataStructureType::LINKED_LIST, field);
     }
 
     auto end = std::chrono::high_resolution_clock::now();
@@ -359,26 +593,19 @@ void performSort(TransactionManager* manager) {
     std::cout << Color::CYAN << "First 10 sorted results:" << Color::RESET << "\n";
     std::cout << std::string(80, '-') << "\n";
     
-    int displayCount = std::min(10, manager->getTransactionCount());
-    for (int i = 0; i < displayCount; ++i) {
-        Transaction* tx = manager->getTransactionPtrAt(i);
-        if (tx) {
-            std::cout << Color::GREEN << "[" << i+1 << "] " << Color::RESET;
-            switch (field) {
-                case SortField::LOCATION:
-                    std::cout << "Location: " << Color::YELLOW << tx->location << Color::RESET
-                              << " | ID: " << tx->transaction_id << "\n";
-                    break;
-                case SortField::AMOUNT:
-                    std::cout << "Amount: " << Color::YELLOW << "$" << tx->amount << Color::RESET
-                              << " | ID: " << tx->transaction_id << "\n";
-                    break;
-                case SortField::TIMESTAMP:
-                    std::cout << "Timestamp: " << Color::YELLOW << tx->timestamp << Color::RESET
-                              << " | ID: " << tx->transaction_id << "\n";
-                    break;
-            }
+    if (manager->isUsingArray() && manager->transactionsArrayView.isActive()) {
+        printFirstSortedRows(manager->transactionsArrayView, field);
+    } else if (manager->isUsingArray()) {
+        printFirstSortedRows(manager->transactionsArray, field);
+    } else if (manager->isUsingColumns()) {
+        const TransactionStore& columns = manager->transactionsColumns;
+        for (int i = 0; i < std::min(10, columns.getSize()); ++i) {
+            printSortedRow(i, columns.getTransaction(i), columns.getText(i), field);
         }
+    } else if (manager->isUsingUnrolledList()) {
+        printFirstSortedRows(manager->transactionsUnrolled, field);
+    } else {
+        printFirstSortedRows(manager->transactionsLinkedList, field);
     }
     std::cout << std::string(80, '-') << "\n";
 
@@ -388,12 +615,17 @@ void performSort(TransactionManager* manager) {
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     
     if (saveChoice == 'y' || saveChoice == 'Y') {
-        saveSortedResultsToJson(manager, field, algoChoice == 1 ? "quick" : "merge");
+        saveSortedResultsToJson(manager, field, sortAlgorithmTag(algoChoice));
     }
 }
 
 void TransactionManager::performFullStructureSortComparison() {
     std::cout << "\n" << Color::BRIGHT_MAGENTA << ">>> ⚡ Sorting Structure Comparison" << Color::RESET << "\n";
+
+    if (isStreaming()) {
+        std::cout << Color::YELLOW << "Not available in streaming mode: nothing is kept in memory to compare." << Color::RESET << "\n";
+        return;
+    }
     
     std::cout << "\n" << Color::CYAN << "Choose field to sort by:" << Color::RESET << "\n";
     std::cout << "1. Location\n";
@@ -421,8 +653,9 @@ void TransactionManager::performFullStructureSortComparison() {
     std::cout << "\n" << Color::CYAN << "Choose algorithm:" << Color::RESET << "\n";
     std::cout << "1. Quick Sort\n";
     std::cout << "2. Merge Sort\n";
+    std::cout << "3. Radix Sort (LSD)\n";
     std::cout << Color::RED << "0. Go Back" << Color::RESET << "\n";
-    std::cout << "Enter choice (0-2): ";
+    std::cout << "Enter choice (0-3): ";
     
     int algoChoice;
     std::cin >> algoChoice;
@@ -430,67 +663,101 @@ void TransactionManager::performFullStructureSortComparison() {
     
     if (algoChoice == 0) return;
     
-    if (algoChoice < 1 || algoChoice > 2) {
+    if (algoChoice < 1 || algoChoice > 3) {
         std::cout << Color::RED << "Invalid choice!" << Color::RESET << "\n";
         return;
     }
+
+    if (!requireColumns(columnsForSort(field), "Sorting by " + getFieldName(field))) {
+        return;
+    }
     
-    auto comparator = [&](const Transaction& a, const Transaction& b) {
-        switch (field) {
-            case SortField::LOCATION: return a.location < b.location;
-            case SortField::AMOUNT: return a.amount < b.amount;
-            case SortField::TIMESTAMP: return a.timestamp < b.timestamp;
-            default: return false;
-        }
-    };
+    CategoryRanks locationRanks(CATEGORY_LOCATION);
 
-    bool original = isUsingArray();
+    DataStructureType original = getActiveStructure();
+    // Build the lists and the columns before the array is sorted so all four
+    // start from the same order.
+    ensureLinkedList();
+    ensureColumnStore();
+    ensureUnrolledList();
+
+    // The merge sort scaling run below starts from the same unsorted keys.
+    uint64_t* scalingKeys = nullptr;
+    if (algoChoice == 2) {
+        scalingKeys = new uint64_t[transactionsArray.getSize()];
+        if (transactionsArrayView.isActive()) {
+            fillSortKeys(transactionsArrayView.begin(), transactionsArrayView.end(), field, locationRanks, scalingKeys);
+        } else {
+            fillSortKeys(transactionsArray.begin(), transactionsArray.end(), field, locationRanks, scalingKeys);
+        }
+    }
 
     std::cout << "\n" << Color::GREEN << "🔵 Testing ARRAY structure..." << Color::RESET << "\n";
-    setActiveDataStructure(true);
+    setActiveDataStructure(DataStructureType::ARRAY);
     long arrayMemBefore = getMemoryUsageKB();
     auto startA = std::chrono::high_resolution_clock::now();
-    if (algoChoice == 1)
-        quickSortArray(transactionsArray.getDataPointer(), 0, transactionsArray.getSize() - 1, comparator);
-    else
-        mergeSortArray(transactionsArray.getDataPointer(), 0, transactionsArray.getSize() - 1, comparator);
+    sortArrayRows(this, field, algoChoice, locationRanks);
+    markSorted(DataStructureType::ARRAY, field);
     auto endA = std::chrono::high_resolution_clock::now();
     auto arrayDuration = std::chrono::duration<double, std::milli>(endA - startA).count();
     long arrayMemAfter = getMemoryUsageKB();
     long arrayMemUsed = arrayMemAfter - arrayMemBefore;
 
     std::cout << Color::BLUE << "🔵 Testing LINKEDLIST structure..." << Color::RESET << "\n";
-    setActiveDataStructure(false);
+    setActiveDataStructure(DataStructureType::LINKED_LIST);
     long listMemBefore = getMemoryUsageKB();
     auto startL = std::chrono::high_resolution_clock::now();
     
-    int nodeCount = 0;
-    TransactionNode* temp = transactionsLinkedList.getHead();
-    while (temp && nodeCount < 5000) {
-        nodeCount++;
-        temp = temp->next;
-    }
-    
-    TransactionNode* sorted;
-    if (nodeCount >= 5000) {
-        sorted = mergeSortLinkedListIterative(transactionsLinkedList.getHead(), comparator);
+    if (algoChoice == 3) {
+        radixSortList(transactionsLinkedList, field, locationRanks);
     } else {
-        sorted = mergeSortLinkedList(transactionsLinkedList.getHead(), comparator);
+        int nodeCount = 0;
+        TransactionNode* temp = transactionsLinkedList.getHead();
+        while (temp && nodeCount < 5000) {
+            nodeCount++;
+            temp = temp->next;
+        }
+
+        TransactionNode* sorted;
+        withTransactionLess(field, &locationRanks, [&](const auto& comparator) {
+            if (nodeCount >= 5000) {
+                sorted = mergeSortLinkedListIterative(transactionsLinkedList.getHead(), comparator);
+            } else {
+                sorted = mergeSortLinkedList(transactionsLinkedList.getHead(), comparator);
+            }
+        });
+        transactionsLinkedList.adoptSortedChain(sorted);
     }
-    
-    TransactionLinkedList newList;
-    for (TransactionNode* n = sorted; n; n = n->next)
-        newList.addTransaction(n->data);
-    transactionsLinkedList = newList;
+    markSorted(DataStructureType::LINKED_LIST, field);
     auto endL = std::chrono::high_resolution_clock::now();
     auto listDuration = std::chrono::duration<double, std::milli>(endL - startL).count();
     long listMemAfter = getMemoryUsageKB();
     long listMemUsed = listMemAfter - listMemBefore;
 
+    std::cout << Color::MAGENTA << "🔵 Testing COLUMNAR structure..." << Color::RESET << "\n";
+    setActiveDataStructure(DataStructureType::COLUMNAR);
+    long columnsMemBefore = getMemoryUsageKB();
+    auto startC = std::chrono::high_resolution_clock::now();
+    sortColumnStore(transactionsColumns, field, algoChoice, &locationRanks);
+    markSorted(DataStructureType::COLUMNAR, field);
+    auto endC = std::chrono::high_resolution_clock::now();
+    auto columnsDuration = std::chrono::duration<double, std::milli>(endC - startC).count();
+    long columnsMemUsed = getMemoryUsageKB() - columnsMemBefore;
+
+    std::cout << Color::CYAN << "🔵 Testing UNROLLED LINKEDLIST structure..." << Color::RESET << "\n";
+    setActiveDataStructure(DataStructureType::UNROLLED_LIST);
+    long unrolledMemBefore = getMemoryUsageKB();
+    auto startU = std::chrono::high_resolution_clock::now();
+    sortUnrolledList(transactionsUnrolled, field, algoChoice, &locationRanks);
+    markSorted(DataStructureType::UNROLLED_LIST, field);
+    auto endU = std::chrono::high_resolution_clock::now();
+    auto unrolledDuration = std::chrono::duration<double, std::milli>(endU - startU).count();
+    long unrolledMemUsed = getMemoryUsageKB() - unrolledMemBefore;
+
     std::cout << std::fixed << std::setprecision(2);
     std::cout << "\n" << Color::BOLD << Color::BRIGHT_CYAN 
               << "📊 Sorting Comparison (" << getFieldName(field) << ", " 
-              << (algoChoice == 1 ? "QuickSort" : "MergeSort") << ")" << Color::RESET << "\n";
+              << sortAlgorithmName(algoChoice) << ")" << Color::RESET << "\n";
     std::cout << std::string(60, '=') << "\n";
     std::cout << std::left << std::setw(25) << Color::GREEN + "Array Time:" + Color::RESET
               << std::right << std::setw(15) << arrayDuration << " ms\n";
@@ -500,19 +767,36 @@ void TransactionManager::performFullStructureSortComparison() {
               << std::right << std::setw(15) << listDuration << " ms\n";
     std::cout << std::left << std::setw(25) << Color::BLUE + "LinkedList Memory:" + Color::RESET
               << std::right << std::setw(15) << listMemUsed << " KB\n";
+    std::cout << std::left << std::setw(25) << Color::MAGENTA + "Columnar Time:" + Color::RESET
+              << std::right << std::setw(15) << columnsDuration << " ms\n";
+    std::cout << std::left << std::setw(25) << Color::MAGENTA + "Columnar Memory:" + Color::RESET
+              << std::right << std::setw(15) << columnsMemUsed << " KB\n";
+    std::cout << std::left << std::setw(25) << Color::CYAN + "Unrolled Time:" + Color::RESET
+              << std::right << std::setw(15) << unrolledDuration << " ms\n";
+    std::cout << std::left << std::setw(25) << Color::CYAN + "Unrolled Memory:" + Color::RESET
+              << std::right << std::setw(15) << unrolledMemUsed << " KB\n";
     std::cout << std::string(60, '-') << "\n";
     
-    if (arrayDuration > 0 && listDuration > 0) {
-        if (arrayDuration < listDuration) {
-            double speedup = listDuration / arrayDuration;
-            std::cout << Color::BRIGHT_GREEN << "🏆 Array is " << speedup << "x faster!" << Color::RESET << "\n";
+    if (arrayDuration > 0 && listDuration > 0 && columnsDuration > 0 && unrolledDuration > 0) {
+        double fastest = std::min({arrayDuration, listDuration, columnsDuration, unrolledDuration});
+        double slowest = std::max({arrayDuration, listDuration, columnsDuration, unrolledDuration});
+        if (fastest == arrayDuration) {
+            std::cout << Color::BRIGHT_GREEN << "🏆 Array is " << slowest / fastest << "x faster than the slowest!" << Color::RESET << "\n";
+        } else if (fastest == listDuration) {
+            std::cout << Color::BRIGHT_BLUE << "🏆 LinkedList is " << slowest / fastest << "x faster than the slowest!" << Color::RESET << "\n";
+        } else if (fastest == unrolledDuration) {
+            std::cout << Color::BRIGHT_CYAN << "🏆 Unrolled LinkedList is " << slowest / fastest << "x faster than the slowest!" << Color::RESET << "\n";
         } else {
-            double speedup = arrayDuration / listDuration;
-            std::cout << Color::BRIGHT_BLUE << "🏆 LinkedList is " << speedup << "x faster!" << Color::RESET << "\n";
+            std::cout << Color::BRIGHT_MAGENTA << "🏆 Columnar is " << slowest / fastest << "x faster than the slowest!" << Color::RESET << "\n";
         }
     }
     std::cout << std::string(60, '=') << "\n";
 
+    if (scalingKeys != nullptr) {
+        printMergeSortScaling(scalingKeys, transactionsArray.getSize(), resolveThreadCount(sortThreadCount));
+        delete[] scalingKeys;
+    }
+
     setActiveDataStructure(original);
     std::cout << "\n" << Color::YELLOW << "📌 Active structure restored to: " 
               << getCurrentDataStructureName() << Color::RESET << "\n";
@@ -526,6 +810,7 @@ void TransactionManager::sortTransactions() {
         std::cout << Color::GREEN << " 1. Perform Sorting" << Color::RESET << "\n";
         std::cout << Color::BLUE << " 2. Compare Structures (Benchmark)" << Color::RESET << "\n";
         std::cout << Color::BRIGHT_MAGENTA << " 3. Switch Active Data Structure" << Color::RESET << "\n";
+        std::cout << Color::BRIGHT_CYAN << " 4. Compare Comparators (Benchmark)" << Color::RESET << "\n";
         std::cout << Color::RED << " 0. Return to Main Menu" << Color::RESET << "\n";
         std::cout << Color::BOLD << Color::CYAN << "==========================================" << Color::RESET << "\n";
         
@@ -534,7 +819,7 @@ void TransactionManager::sortTransactions() {
         std::cout << Color::YELLOW << "Total Transactions: " << Color::BRIGHT_BLUE 
                   << getTransactionCount() << Color::RESET << "\n\n";
         
-        std::cout << "Enter your choice (0-3): ";
+        std::cout << "Enter your choice (0-4): ";
         
         int choice;
         std::cin >> choice;
@@ -563,6 +848,11 @@ void TransactionManager::sortTransactions() {
                 std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
                 switchDataStructure();
                 break;
+
+            case 4:
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                compareSortComparators();
+                break;
                 
             default:
                 std::cout << Color::RED << "Invalid choice! Please try again." << Color::RESET << "\n";
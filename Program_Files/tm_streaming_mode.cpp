@@ -0,0 +1,132 @@
+#include "transaction_manager.h"
+#include "fast_csv_reader.h"
+#include "parallel_csv_parser.h"
+#include <iostream>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+
+// Rough resident cost of one row: the node itself, its text record and the
+// heap part of its strings. A quarter of the budget goes to the batch (sorting may
+// double that); the rest covers the parser window and process overhead.
+static const long ESTIMATED_BYTES_PER_ROW = static_cast<long>(sizeof(TransactionNode) + sizeof(TransactionText)) + 96;
+
+long getPeakMemoryUsageKB() {
+    long hwm = 0L;
+    FILE* fp = fopen("/proc/self/status", "r");
+    if (fp != NULL) {
+        char line[128];
+        while (fgets(line, 128, fp) != NULL) {
+            if (strncmp(line, "VmHWM:", 6) == 0) {
+                char* p = line;
+                while (*p && !isdigit(*p)) p++;
+                hwm = atol(p);
+                break;
+            }
+        }
+        fclose(fp);
+    }
+    return hwm;
+}
+
+void resetPeakMemoryUsage() {
+    // Writing 5 to clear_refs resets VmHWM to the current RSS (Linux 4.0+).
+    FILE* fp = fopen("/proc/self/clear_refs", "w");
+    if (fp != NULL) {
+        fputs("5", fp);
+        fclose(fp);
+    }
+}
+
+bool TransactionManager::enableStreamingMode(const std::string& filePath, long memoryBudgetMB) {
+    if (isMultiFileSource(filePath)) {
+        std::cerr << "Streaming mode reads a single CSV file, not " << filePath << "\n";
+        return false;
+    }
+    MappedCsvFile file;
+    if (!file.open(filePath)) {
+        return false;
+    }
+    const char* cursor = file.begin();
+    CsvColumnLayout layout;
+    if (!layout.parseHeader(cursor, file.end())) {
+        return false;
+    }
+
+    streamingMode = true;
+    streamSourcePath = filePath;
+    loadedColumns = ALL_CSV_COLUMNS;
+    // Nothing stays resident in streaming mode, including the preallocated array.
+    transactionsArrayView = TransactionArrayView();
+    transactionsArray = TransactionArray();
+    streamMemoryBudgetMB = memoryBudgetMB > 0 ? memoryBudgetMB : 256;
+
+    std::cout << "📡 Streaming mode: " << filePath << " (" << file.size() / (1024 * 1024) << " MB) is processed in batches of "
+              << getStreamBatchRows() << " rows to stay within " << streamMemoryBudgetMB << " MB.\n";
+    return true;
+}
+
+int TransactionManager::getStreamBatchRows() const {
+    long rows = streamMemoryBudgetMB * 1024L * 1024L / 4 / ESTIMATED_BYTES_PER_ROW;
+    if (rows < 1000) rows = 1000;
+    if (rows > INT_MAX / 2) rows = INT_MAX / 2;
+    return static_cast<int>(rows);
+}
+
+bool TransactionManager::forEachStreamBatch(const std::function<bool(TransactionArray& batch)>& process) {
+    MappedCsvFile file;
+    if (!file.open(streamSourcePath)) {
+        return false;
+    }
+    const char* cursor = file.begin();
+    CsvColumnLayout layout;
+    if (!layout.parseHeader(cursor, file.end())) {
+        return false;
+    }
+
+    const int batchRows = getStreamBatchRows();
+    const int threads = resolveThreadCount(parseThreadCount);
+    std::size_t maxChunkBytes = static_cast<std::size_t>(streamMemoryBudgetMB) * 1024 * 1024 / 16 / (2 * threads);
+    if (maxChunkBytes < (256u << 10)) maxChunkBytes = 256u << 10;
+
+    CsvParseOptions options;
+    options.maxChunkBytes = maxChunkBytes;
+    options.rejects = rejectLog;
+    options.sourceName = streamSourcePath;
+    if (rejectLog != nullptr) rejectLog->resetCounts();
+
+    TransactionArray* batch = new TransactionArray(batchRows);
+    long delivered = 0;
+    bool keepGoing = true;
+    bool ok = true;
+    try {
+        parseCsvChunksInOrder(cursor, file.end(), layout, threads, [&](TransactionArray& rows) {
+            for (int i = 0; i < rows.getSize(); ++i) {
+                if (rowLimit > 0 && delivered >= rowLimit) {
+                    return false;
+                }
+                Transaction& tx = *rows.getTransaction(i);
+                batch->addTransaction(tx, rows.getText(tx));
+                delivered++;
+                if (batch->getSize() == batchRows) {
+                    keepGoing = process(*batch);
+                    delete batch;
+                    batch = new TransactionArray(batchRows);
+                    if (!keepGoing) return false;
+                }
+            }
+            return true;
+        }, options);
+        if (keepGoing && batch->getSize() > 0) {
+            keepGoing = process(*batch);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading " << streamSourcePath << ": " << e.what() << "\n";
+        ok = false;
+    }
+    delete batch;
+    if (rejectLog != nullptr) rejectLog->printSummary("Reading " + streamSourcePath);
+    return ok;
+}
@@ -0,0 +1,276 @@
+#include "transaction_manager.h"
+#include "fast_csv_reader.h"
+#include "parallel_csv_parser.h"
+#include "transaction_fields.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+
+static bool sortsBefore(SortField field, const CategoryRanks& locationRanks, const Transaction& a, const Transaction& b) {
+    switch (field) {
+        case SortField::LOCATION: return locationRanks[a.location] < locationRanks[b.location];
+        case SortField::AMOUNT: return a.amount < b.amount;
+        case SortField::TIMESTAMP: return a.timestamp < b.timestamp;
+        default: return false;
+    }
+}
+
+void TransactionManager::markSorted(DataStructureType structure, SortField field) {
+    if (structure == DataStructureType::ARRAY) {
+        arraySorted = true;
+        arraySortField = field;
+    } else if (structure == DataStructureType::LINKED_LIST) {
+        listSorted = true;
+        listSortField = field;
+    } else if (structure == DataStructureType::COLUMNAR) {
+        columnsSorted = true;
+        columnsSortField = field;
+    } else {
+        unrolledSorted = true;
+        unrolledSortField = field;
+    }
+}
+
+// New rows go after existing rows with an equal key, as a stable sort of
+// the whole file would place them.
+static void mergeIntoArray(TransactionArray& array, TransactionArray& fresh, SortField field, const CategoryRanks& ranks) {
+    auto less = [&](const Transaction& a, const Transaction& b) { return sortsBefore(field, ranks, a, b); };
+    const int oldSize = array.getSize();
+    for (int i = 0; i < fresh.getSize(); ++i) {
+        Transaction& tx = *fresh.getTransaction(i);
+        array.addTransaction(tx, fresh.getText(tx));
+    }
+    Transaction* data = array.getDataPointer();
+    std::inplace_merge(data, data + oldSize, data + array.getSize(), less);
+}
+
+static void mergeIntoList(TransactionLinkedList& list, const TransactionArray& fresh, SortField field, const CategoryRanks& ranks) {
+    TransactionNode* previous = nullptr;
+    TransactionNode* current = list.getHead();
+    for (int i = 0; i < fresh.getSize(); ++i) {
+        const Transaction& tx = *fresh.getTransaction(i);
+        while (current && !sortsBefore(field, ranks, tx, current->data)) {
+            previous = current;
+            current = current->next;
+        }
+        previous = list.insertAfter(previous, tx, fresh.getText(tx));
+    }
+}
+
+// Like mergeIntoList, with the position kept as a block and a slot in it.
+static void mergeIntoUnrolled(TransactionUnrolledList& list, const TransactionArray& fresh, SortField field,
+                              const CategoryRanks& ranks) {
+    TransactionBlock* block = list.getHead();
+    int slot = 0;
+    for (int i = 0; i < fresh.getSize(); ++i) {
+        const Transaction& tx = *fresh.getTransaction(i);
+        while (block && !sortsBefore(field, ranks, tx, block->rows[slot])) {
+            if (++slot == block->count) {
+                block = block->next;
+                slot = 0;
+            }
+        }
+        block = list.insertAt(block, slot, tx, fresh.getText(tx), slot);
+        if (++slot == block->count) {
+            block = block->next;
+            slot = 0;
+        }
+    }
+}
+
+// Same as mergeIntoArray for an array read through a view: the new rows are
+// appended to the records, which stay put, and only their row indices are
+// merged into the view's order.
+static void mergeIntoArrayView(TransactionArray& array, TransactionArrayView& view, TransactionArray& fresh,
+                               SortField field, const CategoryRanks& ranks) {
+    const int oldSize = array.getSize();
+    array.adoptRows(fresh, fresh.getSize());
+    const int size = array.getSize();
+    const Transaction* data = array.getDataPointer();
+    const int* previous = view.getRows();
+    int* order = new int[size];
+    int i = 0, next = oldSize, out = 0;
+    while (i < oldSize && next < size) {
+        order[out++] = sortsBefore(field, ranks, data[next], data[previous[i]]) ? next++ : previous[i++];
+    }
+    while (i < oldSize) order[out++] = previous[i++];
+    while (next < size) order[out++] = next++;
+    view = TransactionArrayView(array, order);
+}
+
+// The store has no records to move, so the merge runs over row indices and
+// the columns are permuted once at the end.
+static void mergeIntoColumns(TransactionStore& store, const TransactionArray& fresh, bool sorted, SortField field,
+                             const CategoryRanks& ranks) {
+    const int oldSize = store.getSize();
+    for (int i = 0; i < fresh.getSize(); ++i) {
+        const Transaction& tx = *fresh.getTransaction(i);
+        store.addTransaction(tx, fresh.getText(tx));
+    }
+    if (!sorted) {
+        return;
+    }
+    const int size = store.getSize();
+    const uint16_t* locations = store.getLocations();
+    const double* amounts = store.getAmounts();
+    const int64_t* timestamps = store.getTimestamps();
+    auto less = [&](int a, int b) {
+        switch (field) {
+            case SortField::LOCATION: return ranks[locations[a]] < ranks[locations[b]];
+            case SortField::AMOUNT: return amounts[a] < amounts[b];
+            case SortField::TIMESTAMP: return timestamps[a] < timestamps[b];
+            default: return false;
+        }
+    };
+    int* order = new int[size];
+    for (int i = 0; i < size; ++i) {
+        order[i] = i;
+    }
+    // The new rows arrive in file order.
+    std::stable_sort(order + oldSize, order + size, less);
+    std::inplace_merge(order, order + oldSize, order + size, less);
+    store.reorder(order);
+    delete[] order;
+}
+
+int TransactionManager::appendNewRows() {
+    if (streamingMode) {
+        std::cout << Color::YELLOW << "Streaming mode re-reads " << streamSourcePath
+                  << " for every operation, so appended rows are always included." << Color::RESET << "\n";
+        return 0;
+    }
+    if (loadedSourcePath.empty()) {
+        return 0;
+    }
+    if (multiFileSource) {
+        std::cerr << Color::YELLOW << "New rows can only be tailed from a single CSV file; restart to load new files from "
+                  << loadedSourcePath << "." << Color::RESET << "\n";
+        return -1;
+    }
+    if (rowLimit > 0 && transactionsArray.getSize() >= rowLimit) {
+        std::cout << Color::YELLOW << "Row limit of " << rowLimit << " reached; new rows are not loaded." << Color::RESET << "\n";
+        return 0;
+    }
+
+    MappedCsvFile file;
+    if (!file.open(loadedSourcePath)) {
+        return -1;
+    }
+    if (file.size() < loadedByteOffset) {
+        std::cerr << Color::RED << loadedSourcePath << " is smaller than when it was loaded (" << file.size() << " < "
+                  << loadedByteOffset << " bytes); it was replaced or truncated. Restart to load it again."
+                  << Color::RESET << "\n";
+        return -1;
+    }
+    const char* cursor = file.begin();
+    CsvColumnLayout layout;
+    if (!layout.parseHeader(cursor, file.end())) {
+        return -1;
+    }
+
+    // A row the writer has not finished yet is left for the next call.
+    const char* from = file.begin() + loadedByteOffset;
+    const char* to = lastCompleteLineEnd(from, file.end());
+    if (to == from) {
+        return 0;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    TransactionArray fresh(estimateCsvRowCount(from, to), textStorage);
+    CsvParseOptions options;
+    options.columns = loadedColumns;
+    options.textStorage = textStorage;
+    options.rejects = rejectLog;
+    // Lines are counted from the first appended row.
+    options.sourceName = loadedSourcePath + " (after byte " + std::to_string(loadedByteOffset) + ")";
+    options.firstLineNumber = 1;
+    if (rejectLog != nullptr) rejectLog->resetCounts();
+    try {
+        parseCsvChunksInOrder(from, to, layout, parseThreadCount, [&](TransactionArray& rows) {
+            int take = rows.getSize();
+            if (rowLimit > 0 && transactionsArray.getSize() + fresh.getSize() + take > rowLimit) {
+                take = static_cast<int>(rowLimit - transactionsArray.getSize() - fresh.getSize());
+            }
+            fresh.adoptRows(rows, take);
+            return rowLimit <= 0 || transactionsArray.getSize() + fresh.getSize() < rowLimit;
+        }, options);
+    } catch (const std::exception& e) {
+        std::cerr << Color::RED << "Error reading the rows appended to " << loadedSourcePath << " after byte "
+                  << loadedByteOffset << ": " << e.what() << Color::RESET << "\n";
+        return -1;
+    }
+    auto parsed = std::chrono::high_resolution_clock::now();
+
+    waitForBackgroundListBuild();
+    const int added = fresh.getSize();
+    CategoryRanks locationRanks(CATEGORY_LOCATION);
+    // fresh stays in file order for the structures that are not sorted; each
+    // sorted one merges in a copy sorted by its own field.
+    auto sortedCopy = [&](SortField field) {
+        TransactionArray rows(fresh);
+        Transaction* data = rows.getDataPointer();
+        std::stable_sort(data, data + added, [&](const Transaction& a, const Transaction& b) {
+            return sortsBefore(field, locationRanks, a, b);
+        });
+        return rows;
+    };
+
+    if (linkedListReady) {
+        if (listSorted) {
+            mergeIntoList(transactionsLinkedList, sortedCopy(listSortField), listSortField, locationRanks);
+        } else {
+            for (int i = 0; i < added; ++i) {
+                const Transaction& tx = *fresh.getTransaction(i);
+                transactionsLinkedList.addTransaction(tx, fresh.getText(tx));
+            }
+        }
+    }
+
+    if (unrolledListReady) {
+        if (unrolledSorted) {
+            mergeIntoUnrolled(transactionsUnrolled, sortedCopy(unrolledSortField), unrolledSortField, locationRanks);
+        } else {
+            for (int i = 0; i < added; ++i) {
+                const Transaction& tx = *fresh.getTransaction(i);
+                transactionsUnrolled.addTransaction(tx, fresh.getText(tx));
+            }
+        }
+    }
+
+    if (columnStoreReady) {
+        mergeIntoColumns(transactionsColumns, fresh, columnsSorted, columnsSortField, locationRanks);
+    }
+
+    if (arraySorted && transactionsArrayView.isActive()) {
+        TransactionArray forArray = sortedCopy(arraySortField);
+        mergeIntoArrayView(transactionsArray, transactionsArrayView, forArray, arraySortField, locationRanks);
+    } else if (arraySorted) {
+        TransactionArray forArray = sortedCopy(arraySortField);
+        mergeIntoArray(transactionsArray, forArray, arraySortField, locationRanks);
+    } else {
+        // The array is filled last, so it can take fresh's text as it is.
+        transactionsArray.adoptRows(fresh, added);
+    }
+    loadedByteOffset = static_cast<std::size_t>(to - file.begin());
+    if (rejectLog != nullptr) rejectLog->printSummary("Reading the new rows");
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << Color::CYAN << "📥 " << added << " new transaction(s) loaded from " << loadedSourcePath << " (parse "
+              << std::chrono::duration<double, std::milli>(parsed - start).count() << " ms, "
+              << (arraySorted || listSorted || columnsSorted || unrolledSorted ? "merge " : "append ")
+              << std::chrono::duration<double, std::milli>(end - parsed).count() << " ms). Total: "
+              << transactionsArray.getSize() << Color::RESET << "\n";
+    return added;
+}
+
+void TransactionManager::pollForNewRows() {
+    if (tailPollSeconds <= 0 || streamingMode) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastTailPoll < std::chrono::seconds(tailPollSeconds)) {
+        return;
+    }
+    lastTailPoll = now;
+    appendNewRows();
+}
@@ -1,18 +1,59 @@
 #ifndef TRANSACTION_H
 #define TRANSACTION_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 
+// The columns sorts and filters read, kept in one compact record so a scan
+// over a TransactionArray streams through about one cache line per row.
+// Columns with a fixed shape are parsed into native types at load time; see
+// transaction_fields.h for the conversions back to text. The free-text
+// columns are kept by the container's TransactionTextStore at index
+// textRow, and are only read for display and export.
 struct Transaction {
-    std::string transaction_id, timestamp,
+    // Columns left out of a projected load keep these defaults.
+    int64_t timestamp = 0;                // microseconds since the Unix epoch
+    double amount = 0, spending_deviation_score = 0,
+           velocity_score = 0, geo_anomaly_score = 0;
+    double time_since_last_transaction = __builtin_nan("");  // NaN when the CSV field is empty
+    uint32_t ip_address = 0;              // IPv4, first octet in the top byte
+    uint32_t textRow = 0;
+    uint16_t merchant_category = 0, location = 0;  // CategoryCode of the matching column
+    uint8_t transaction_type = 0, device_used = 0,
+            payment_channel = 0, fraud_type = 0;   // likewise, for columns of at most 256 values
+    bool is_fraud = false;
+};
+
+// The free-text columns of one row, owning their characters. Parsers fill
+// one per row and hand it to a container, which keeps its own copy.
+struct TransactionText {
+    std::string transaction_id,
                 sender_account, receiver_account,
-                transaction_type, merchant_category,
-                location, device_used,
-                fraud_type, time_since_last_transaction,
-                payment_channel, ip_address, device_hash;
-    double amount, spending_deviation_score,
-           velocity_score, geo_anomaly_score;
-    bool is_fraud;
+                device_hash;
+};
+
+// The free-text columns of one row as read back from a container. The
+// views point into the container's storage and stay valid until that
+// container is next changed or destroyed.
+struct TransactionTextView {
+    std::string_view transaction_id,
+                     sender_account, receiver_account,
+                     device_hash;
+
+    TransactionTextView() = default;
+    TransactionTextView(const TransactionText& text)
+        : transaction_id(text.transaction_id), sender_account(text.sender_account),
+          receiver_account(text.receiver_account), device_hash(text.device_hash) {}
+
+    TransactionText toText() const {
+        TransactionText text;
+        text.transaction_id.assign(transaction_id);
+        text.sender_account.assign(sender_account);
+        text.receiver_account.assign(receiver_account);
+        text.device_hash.assign(device_hash);
+        return text;
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,439 @@
+#include "transaction_fields.h"
+#include "third_party/rapidjson/include/rapidjson/internal/strtod.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+const char* parseErrorKindName(ParseErrorKind kind) {
+    switch (kind) {
+        case ParseErrorKind::ROW_SHAPE: return "column count";
+        case ParseErrorKind::QUOTING: return "quoting";
+        case ParseErrorKind::TIMESTAMP: return "timestamp";
+        case ParseErrorKind::NUMBER: return "number";
+        case ParseErrorKind::IP_ADDRESS: return "IPv4 address";
+        case ParseErrorKind::CATEGORY_LIMIT: return "category limit";
+        default: return "other";
+    }
+}
+
+static ParseError invalidField(ParseErrorKind kind, const char* text, std::size_t length) {
+    return ParseError(kind, std::string("invalid ") + parseErrorKindName(kind) + " \"" + std::string(text, length) + "\"");
+}
+
+static bool readDigits(const char*& p, const char* end, int count, int& value) {
+    if (end - p < count) return false;
+    value = 0;
+    for (int i = 0; i < count; ++i, ++p) {
+        if (*p < '0' || *p > '9') return false;
+        value = value * 10 + (*p - '0');
+    }
+    return true;
+}
+
+static bool expectChar(const char*& p, const char* end, char c) {
+    if (p == end || *p != c) return false;
+    ++p;
+    return true;
+}
+
+// Proleptic Gregorian calendar conversions (Howard Hinnant's days_from_civil
+// and civil_from_days), valid for any year.
+static int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+static void civilFromDays(int64_t z, int64_t& y, unsigned& m, unsigned& d) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+}
+
+static unsigned daysInMonth(int64_t y, unsigned m) {
+    static const unsigned DAYS[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if (m == 2 && (y % 4 == 0 && (y % 100 != 0 || y % 400 == 0))) return 29;
+    return DAYS[m - 1];
+}
+
+int64_t parseTimestampMicros(const char* text, std::size_t length) {
+    const char* p = text;
+    const char* end = text + length;
+    int year, month, day, hour, minute, second;
+    bool ok = readDigits(p, end, 4, year) && expectChar(p, end, '-')
+           && readDigits(p, end, 2, month) && expectChar(p, end, '-')
+           && readDigits(p, end, 2, day)
+           && (expectChar(p, end, 'T') || expectChar(p, end, ' '))
+           && readDigits(p, end, 2, hour) && expectChar(p, end, ':')
+           && readDigits(p, end, 2, minute) && expectChar(p, end, ':')
+           && readDigits(p, end, 2, second);
+    if (!ok || month < 1 || month > 12 || day < 1 || static_cast<unsigned>(day) > daysInMonth(year, month)
+        || hour > 23 || minute > 59 || second > 59) {
+        throw invalidField(ParseErrorKind::TIMESTAMP, text, length);
+    }
+
+    int64_t fraction = 0;
+    if (p < end && *p == '.') {
+        ++p;
+        int digits = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            // Anything past microsecond precision is truncated.
+            if (digits < 6) fraction = fraction * 10 + (*p - '0');
+            ++digits;
+            ++p;
+        }
+        if (digits == 0) throw invalidField(ParseErrorKind::TIMESTAMP, text, length);
+        for (; digits < 6; ++digits) fraction *= 10;
+    }
+    if (p != end) throw invalidField(ParseErrorKind::TIMESTAMP, text, length);
+
+    const int64_t days = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    const int64_t seconds = days * 86400 + hour * 3600 + minute * 60 + second;
+    return seconds * 1000000 + fraction;
+}
+
+int formatTimestampMicros(int64_t micros, char* buffer) {
+    int64_t seconds = micros / 1000000;
+    int64_t fraction = micros % 1000000;
+    if (fraction < 0) {
+        fraction += 1000000;
+        seconds -= 1;
+    }
+    int64_t days = seconds / 86400;
+    int64_t secondOfDay = seconds % 86400;
+    if (secondOfDay < 0) {
+        secondOfDay += 86400;
+        days -= 1;
+    }
+    int64_t year;
+    unsigned month, day;
+    civilFromDays(days, year, month, day);
+
+    int n = std::snprintf(buffer, FIELD_TEXT_CAPACITY, "%04lld-%02u-%02uT%02d:%02d:%02d",
+                          static_cast<long long>(year), month, day, static_cast<int>(secondOfDay / 3600),
+                          static_cast<int>(secondOfDay / 60 % 60), static_cast<int>(secondOfDay % 60));
+    if (fraction != 0) {
+        n += std::snprintf(buffer + n, FIELD_TEXT_CAPACITY - n, ".%06d", static_cast<int>(fraction));
+    }
+    return n;
+}
+
+std::string timestampToString(int64_t micros) {
+    char buffer[FIELD_TEXT_CAPACITY];
+    return std::string(buffer, formatTimestampMicros(micros, buffer));
+}
+
+uint32_t parseIPv4(const char* text, std::size_t length) {
+    const char* p = text;
+    const char* end = text + length;
+    uint32_t address = 0;
+    for (int octet = 0; octet < 4; ++octet) {
+        if (octet > 0 && !expectChar(p, end, '.')) throw invalidField(ParseErrorKind::IP_ADDRESS, text, length);
+        int value = 0;
+        int digits = 0;
+        while (p < end && *p >= '0' && *p <= '9' && digits < 3) {
+            value = value * 10 + (*p - '0');
+            ++digits;
+            ++p;
+        }
+        if (digits == 0 || value > 255) throw invalidField(ParseErrorKind::IP_ADDRESS, text, length);
+        address = (address << 8) | static_cast<uint32_t>(value);
+    }
+    if (p != end) throw invalidField(ParseErrorKind::IP_ADDRESS, text, length);
+    return address;
+}
+
+int formatIPv4(uint32_t address, char* buffer) {
+    return std::snprintf(buffer, FIELD_TEXT_CAPACITY, "%u.%u.%u.%u", (address >> 24) & 0xFF,
+                         (address >> 16) & 0xFF, (address >> 8) & 0xFF, address & 0xFF);
+}
+
+std::string ipv4ToString(uint32_t address) {
+    char buffer[FIELD_TEXT_CAPACITY];
+    return std::string(buffer, formatIPv4(address, buffer));
+}
+
+// Digits beyond this many are rare enough to hand to strtod on a copy.
+static const int MAX_PARSED_DIGITS = 64;
+
+bool parseDouble(const char* text, std::size_t length, double& value) {
+    const char* p = text;
+    const char* end = text + length;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    // All mantissa digits without the '.', as RapidJSON's full-precision
+    // path expects them; integerDigits marks where the point was.
+    char digits[MAX_PARSED_DIGITS];
+    int digitCount = 0;
+    int integerDigits = 0;
+    bool tooLong = false;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (digitCount < MAX_PARSED_DIGITS) digits[digitCount] = *p; else tooLong = true;
+        ++digitCount;
+        ++integerDigits;
+        ++p;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (digitCount < MAX_PARSED_DIGITS) digits[digitCount] = *p; else tooLong = true;
+            ++digitCount;
+            ++p;
+        }
+    }
+    if (digitCount == 0) return false;
+
+    int exponent = 0;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        if (p == end || *p < '0' || *p > '9') return false;
+        while (p < end && *p >= '0' && *p <= '9') {
+            // Anything this large is 0 or infinity either way.
+            if (exponent < 100000) exponent = exponent * 10 + (*p - '0');
+            ++p;
+        }
+        if (negativeExponent) exponent = -exponent;
+    }
+    if (p != end) return false;
+
+    // Only the first MAX_PARSED_DIGITS digits were kept, so an overlong
+    // mantissa goes to strtod before anything reads them.
+    if (tooLong) {
+        std::string copy(text, length);
+        value = std::strtod(copy.c_str(), nullptr);
+        return true;
+    }
+
+    int first = 0;
+    while (first < digitCount && digits[first] == '0') ++first;
+
+    // Values of 1e308 and up may overflow, which the RapidJSON routines do not
+    // detect; like overlong mantissas they are left to strtod.
+    if (first < digitCount && exponent + integerDigits - first > 308) {
+        std::string copy(text, length);
+        value = std::strtod(copy.c_str(), nullptr);
+        return true;
+    }
+
+    // Up to 17 significant digits give the approximation the fast path and
+    // DiyFp stages start from; exact whenever there are 15 or fewer.
+    int used = digitCount - first < 17 ? digitCount - first : 17;
+    double significand = 0.0;
+    for (int i = first; i < first + used; ++i) {
+        significand = significand * 10.0 + (digits[i] - '0');
+    }
+    int power = exponent + integerDigits - (first + used);
+
+    double magnitude = rapidjson::internal::StrtodFullPrecision(significand, power, digits,
+                                                                 static_cast<std::size_t>(digitCount),
+                                                                 static_cast<std::size_t>(integerDigits), exponent);
+    value = negative ? -magnitude : magnitude;
+    return true;
+}
+
+double parseRequiredDouble(const char* text, std::size_t length) {
+    double value;
+    if (!parseDouble(text, length, value)) throw invalidField(ParseErrorKind::NUMBER, text, length);
+    return value;
+}
+
+double parseNullableDouble(const char* text, std::size_t length) {
+    if (length == 0) return std::numeric_limits<double>::quiet_NaN();
+    return parseRequiredDouble(text, length);
+}
+
+int formatNullableDouble(double value, char* buffer) {
+    if (std::isnan(value)) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    int n = 0;
+    for (int precision = 15; precision <= 17; ++precision) {
+        n = std::snprintf(buffer, FIELD_TEXT_CAPACITY, "%.*g", precision, value);
+        double parsed;
+        if (parseDouble(buffer, static_cast<std::size_t>(n), parsed) && parsed == value) break;
+    }
+    return n;
+}
+
+std::string nullableDoubleToString(double value) {
+    char buffer[FIELD_TEXT_CAPACITY];
+    return std::string(buffer, formatNullableDouble(value, buffer));
+}
+
+bool isNullValue(double value) {
+    return std::isnan(value);
+}
+
+namespace {
+
+const int NAME_BLOCK_SIZE = 256;
+
+// Names live in fixed blocks that never move, and both the blocks and the
+// hash slots are written before count (or the slot) is published, so readers
+// need no lock: any code they can see refers to a fully written name.
+struct CategoryDictionary {
+    const int capacity;
+    const int slotMask;
+    std::string* blocks[MAX_CATEGORY_VALUES / NAME_BLOCK_SIZE];
+    std::atomic<int32_t>* slots;    // open-addressing index: code + 1, 0 = empty
+    std::atomic<int> count;
+    std::mutex appendLock;
+
+    CategoryDictionary(int capacity)
+        : capacity(capacity), slotMask(capacity * 2 - 1), slots(new std::atomic<int32_t>[capacity * 2]), count(1) {
+        for (int b = 0; b < MAX_CATEGORY_VALUES / NAME_BLOCK_SIZE; ++b) blocks[b] = nullptr;
+        for (int s = 0; s <= slotMask; ++s) slots[s].store(0, std::memory_order_relaxed);
+        blocks[0] = new std::string[NAME_BLOCK_SIZE];
+        // Code 0 is the empty string.
+        slots[hash("", 0) & slotMask].store(1, std::memory_order_relaxed);
+    }
+
+    const std::string& name(int code) const {
+        return blocks[code / NAME_BLOCK_SIZE][code % NAME_BLOCK_SIZE];
+    }
+
+    static uint32_t hash(const char* text, std::size_t length) {
+        uint32_t h = 2166136261u;   // FNV-1a
+        for (std::size_t i = 0; i < length; ++i) {
+            h = (h ^ static_cast<unsigned char>(text[i])) * 16777619u;
+        }
+        return h;
+    }
+
+    // Returns the code, or -1 with slot set to where the value would go.
+    int probe(const char* text, std::size_t length, int& slot) const {
+        slot = static_cast<int>(hash(text, length)) & slotMask;
+        while (true) {
+            int32_t entry = slots[slot].load(std::memory_order_acquire);
+            if (entry == 0) return -1;
+            const std::string& candidate = name(entry - 1);
+            if (candidate.size() == length && std::memcmp(candidate.data(), text, length) == 0) {
+                return entry - 1;
+            }
+            slot = (slot + 1) & slotMask;
+        }
+    }
+};
+
+CategoryDictionary categoryDictionaries[CATEGORY_COLUMN_COUNT] = {
+    MAX_SMALL_CATEGORY_VALUES,  // transaction_type
+    MAX_SMALL_CATEGORY_VALUES,  // device_used
+    MAX_SMALL_CATEGORY_VALUES,  // payment_channel
+    MAX_SMALL_CATEGORY_VALUES,  // fraud_type
+    MAX_CATEGORY_VALUES,        // merchant_category
+    MAX_CATEGORY_VALUES         // location
+};
+
+}
+
+CategoryCode encodeCategory(CategoryColumn column, const char* text, std::size_t length) {
+    CategoryDictionary& dict = categoryDictionaries[column];
+    int slot;
+    int code = dict.probe(text, length, slot);
+    if (code >= 0) return static_cast<CategoryCode>(code);
+
+    std::lock_guard<std::mutex> lock(dict.appendLock);
+    code = dict.probe(text, length, slot);
+    if (code >= 0) return static_cast<CategoryCode>(code);
+    code = dict.count.load(std::memory_order_relaxed);
+    if (code == dict.capacity) {
+        throw ParseError(ParseErrorKind::CATEGORY_LIMIT, "too many distinct values (\"" + std::string(text, length) + "\")");
+    }
+    if (code % NAME_BLOCK_SIZE == 0) {
+        dict.blocks[code / NAME_BLOCK_SIZE] = new std::string[NAME_BLOCK_SIZE];
+    }
+    dict.blocks[code / NAME_BLOCK_SIZE][code % NAME_BLOCK_SIZE].assign(text, length);
+    dict.count.store(code + 1, std::memory_order_release);
+    dict.slots[slot].store(code + 1, std::memory_order_release);
+    return static_cast<CategoryCode>(code);
+}
+
+const std::string& categoryName(CategoryColumn column, CategoryCode code) {
+    return categoryDictionaries[column].name(code);
+}
+
+int getCategoryCount(CategoryColumn column) {
+    return categoryDictionaries[column].count.load(std::memory_order_acquire);
+}
+
+int getCategoryCapacity(CategoryColumn column) {
+    return categoryDictionaries[column].capacity;
+}
+
+static bool equalsIgnoreCase(const std::string& a, const std::string& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int findCategoryIgnoreCase(CategoryColumn column, const std::string& text) {
+    int count = getCategoryCount(column);
+    for (int code = 0; code < count; ++code) {
+        if (equalsIgnoreCase(categoryName(column, static_cast<CategoryCode>(code)), text)) return code;
+    }
+    return -1;
+}
+
+int findCategoriesContainingIgnoreCase(CategoryColumn column, const std::string& text, uint64_t* matches) {
+    std::string needle = text;
+    for (char& c : needle) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    int count = getCategoryCount(column);
+    for (int word = 0; word < (count + 63) / 64; ++word) matches[word] = 0;
+    for (int code = 0; code < count; ++code) {
+        std::string name = categoryName(column, static_cast<CategoryCode>(code));
+        for (char& c : name) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (name.find(needle) != std::string::npos) {
+            matches[code / 64] |= uint64_t(1) << (code % 64);
+        }
+    }
+    return count;
+}
+
+CategoryRanks::CategoryRanks(CategoryColumn column)
+    : size(getCategoryCount(column)), ranks(new uint16_t[size]) {
+    CategoryCode* order = new CategoryCode[size];
+    for (int i = 0; i < size; ++i) {
+        order[i] = static_cast<CategoryCode>(i);
+    }
+    std::sort(order, order + size, [column](CategoryCode a, CategoryCode b) {
+        return categoryName(column, a) < categoryName(column, b);
+    });
+    for (int i = 0; i < size; ++i) {
+        ranks[order[i]] = static_cast<uint16_t>(i);
+    }
+    delete[] order;
+}
+
+CategoryRanks::~CategoryRanks() {
+    delete[] ranks;
+}
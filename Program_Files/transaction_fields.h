@@ -0,0 +1,120 @@
+#ifndef TRANSACTION_FIELDS_H
+#define TRANSACTION_FIELDS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+// Conversions between the CSV text of the typed Transaction columns and their
+// in-memory representation. The parse functions throw ParseError on
+// text they cannot represent; the format functions write into a caller buffer
+// of at least FIELD_TEXT_CAPACITY bytes and return the length (no terminator
+// is counted, but one is written).
+
+static const int FIELD_TEXT_CAPACITY = 40;
+
+// Why a row could not be converted, so tolerant loads can count rejects by
+// cause. ROW_SHAPE (wrong number of columns) and QUOTING (an unterminated
+// quoted field or text after its closing quote) come from the CSV readers;
+// OTHER covers exceptions that are not a ParseError.
+enum class ParseErrorKind {
+    ROW_SHAPE,
+    QUOTING,
+    TIMESTAMP,
+    NUMBER,
+    IP_ADDRESS,
+    CATEGORY_LIMIT,
+    OTHER,
+    COUNT
+};
+
+const char* parseErrorKindName(ParseErrorKind kind);
+
+class ParseError : public std::runtime_error {
+private:
+    ParseErrorKind kind;
+
+public:
+    ParseError(ParseErrorKind kind, const std::string& message) : std::runtime_error(message), kind(kind) {}
+    ParseErrorKind getKind() const { return kind; }
+};
+
+// "YYYY-MM-DDTHH:MM:SS[.ffffff]" (a space instead of 'T' is accepted) as
+// microseconds since 1970-01-01 UTC. Formatting omits the fraction when it is
+// zero, matching how the dataset was written.
+int64_t parseTimestampMicros(const char* text, std::size_t length);
+int formatTimestampMicros(int64_t micros, char* buffer);
+std::string timestampToString(int64_t micros);
+
+// Dotted-quad IPv4 address, first octet in the most significant byte.
+uint32_t parseIPv4(const char* text, std::size_t length);
+int formatIPv4(uint32_t address, char* buffer);
+std::string ipv4ToString(uint32_t address);
+
+// Locale-independent decimal parser reading straight from a character range
+// ("12", "-0.35", "4.2e-3"; no null terminator needed). The result is
+// correctly rounded, the same double std::strtod would give. parseDouble
+// returns false unless the whole range is one number; parseRequiredDouble
+// throws instead.
+bool parseDouble(const char* text, std::size_t length, double& value);
+double parseRequiredDouble(const char* text, std::size_t length);
+
+// Empty text is stored as NaN; formatting NaN gives an empty string and any
+// other value the shortest text that parses back to the same double.
+double parseNullableDouble(const char* text, std::size_t length);
+int formatNullableDouble(double value, char* buffer);
+std::string nullableDoubleToString(double value);
+bool isNullValue(double value);
+
+// Low-cardinality text columns stored as small integer codes: one byte for
+// the columns with a fixed handful of values, two bytes for merchant_category
+// and location. Each column has its own dictionary shared by every row; code
+// 0 is always the empty string. Dictionaries only grow, so a code stays valid
+// for the life of the process and may be read from any thread without locking.
+enum CategoryColumn {
+    CATEGORY_TRANSACTION_TYPE,
+    CATEGORY_DEVICE_USED,
+    CATEGORY_PAYMENT_CHANNEL,
+    CATEGORY_FRAUD_TYPE,
+    CATEGORY_MERCHANT_CATEGORY,
+    CATEGORY_LOCATION,
+    CATEGORY_COLUMN_COUNT
+};
+
+typedef uint16_t CategoryCode;
+
+static const int MAX_SMALL_CATEGORY_VALUES = 256;
+static const int MAX_CATEGORY_VALUES = 65536;
+
+// Returns the code for the value, adding it on first sight. Throws once a
+// column would exceed getCategoryCapacity() distinct values.
+CategoryCode encodeCategory(CategoryColumn column, const char* text, std::size_t length);
+const std::string& categoryName(CategoryColumn column, CategoryCode code);
+int getCategoryCount(CategoryColumn column);
+int getCategoryCapacity(CategoryColumn column);
+// ASCII case-insensitive lookup without adding; -1 if the value was never seen.
+int findCategoryIgnoreCase(CategoryColumn column, const std::string& text);
+// Sets bit `code` of matches for every value containing text (ASCII
+// case-insensitive) and clears the others; returns the number of codes
+// covered. matches needs room for getCategoryCapacity(column) bits.
+int findCategoriesContainingIgnoreCase(CategoryColumn column, const std::string& text, uint64_t* matches);
+
+// Alphabetical rank of every code known when it was built, so a sort can
+// order rows by one table lookup per side instead of a string compare.
+// Rebuild it if rows with new values may have been loaded since.
+class CategoryRanks {
+private:
+    int size;
+    uint16_t* ranks;
+
+public:
+    explicit CategoryRanks(CategoryColumn column);
+    ~CategoryRanks();
+    CategoryRanks(const CategoryRanks&) = delete;
+    CategoryRanks& operator=(const CategoryRanks&) = delete;
+
+    uint16_t operator[](CategoryCode code) const { return ranks[code]; }
+};
+
+#endif
@@ -1,50 +1,104 @@
 #include "transaction_manager.h"
 #include "csv_json_processing.h"
+#include "sort_algorithms.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <cstdlib>
 #include "third_party/fast-cpp-csv-parser/csv.h"
+#include "fast_csv_reader.h"
+#include "transaction_fields.h"
+#include "parallel_csv_parser.h"
 #include <chrono>
 #include <sys/resource.h>
 #include <cstdio>
 #include <cstring>
-
-static long getMemoryUsageKB() {
-    long rss = 0L;
-    FILE* fp = fopen("/proc/self/status", "r");
-    if (fp != NULL) {
-        char line[128];
-        while (fgets(line, 128, fp) != NULL) {
-            if (strncmp(line, "VmRSS:", 6) == 0) {
-                char* p = line;
-                while (*p && !isdigit(*p)) p++;
-                rss = atol(p);
-                break;
-            }
-        }
-        fclose(fp);
-    }
-    return rss;
-}
+#include <malloc.h>
 
 TransactionManager::TransactionManager()
-    : transactionsArray(500000),
+    : transactionsArray(),
       transactionsLinkedList(),
-      useArrayDataStructure(true)
+      transactionsColumns(),
+      activeStructure(DataStructureType::ARRAY),
+      textStorage(TextStorage::ARENA),
+      parseThreadCount(1),
+      useLegacyCsvReader(false),
+      rowLimit(0),
+      loadedColumns(0),
+      multiFileSource(false),
+      fileLoadThreadCount(0),
+      sortThreadCount(0),
+      rejectLog(nullptr),
+      listBuildMode(ListBuildMode::ON_FIRST_USE),
+      arraySortMode(ArraySortMode::VIEW),
+      linkedListReady(true),
+      listBuildMs(0),
+      columnStoreReady(true),
+      columnBuildMs(0),
+      unrolledListReady(true),
+      unrolledBuildMs(0),
+      loadedByteOffset(0),
+      arraySorted(false),
+      listSorted(false),
+      columnsSorted(false),
+      unrolledSorted(false),
+      arraySortField(SortField::LOCATION),
+      listSortField(SortField::LOCATION),
+      columnsSortField(SortField::LOCATION),
+      unrolledSortField(SortField::LOCATION),
+      tailPollSeconds(0),
+      streamingMode(false),
+      streamMemoryBudgetMB(0)
 {
     std::cout << "🔧 TransactionManager initialized. Both data structures are ready.\n";
     std::cout << "Current active data structure: " << getCurrentDataStructureName() << "\n";
 }
 
+TransactionManager::~TransactionManager() {
+    if (listBuilder.joinable()) {
+        listBuilder.join();
+    }
+}
+
 
-bool TransactionManager::loadTransactionsFromCsv(const std::string& filePath) {
-    std::cout << "Loading transactions from " << filePath << " into BOTH Array and LinkedList...\n";
+static void printLoadedColumns(CsvColumnSet columns) {
+    if (columns == ALL_CSV_COLUMNS) return;
+    int count = 0;
+    for (int c = 0; c < CSV_COLUMN_COUNT; ++c) {
+        if (columns & csvColumnBit(static_cast<CsvColumn>(c))) count++;
+    }
+    std::cout << "Columns loaded:                         " << count << " of " << CSV_COLUMN_COUNT
+              << " (" << csvColumnListToString(columns) << ")\n";
+}
+
+bool TransactionManager::loadTransactionsFromCsv(const std::string& filePath, CsvColumnSet columns) {
+    if (isMultiFileSource(filePath)) {
+        return loadTransactionsFromFiles(filePath, columns);
+    }
+    multiFileSource = false;
+    if (!useLegacyCsvReader) {
+        return loadTransactionsFromCsvMapped(filePath, columns);
+    }
+    loadedSourcePath = filePath;
+    arraySorted = listSorted = columnsSorted = unrolledSorted = false;
+    transactionsArrayView = TransactionArrayView();
+
+    std::cout << "Loading transactions from " << filePath
+              << (listBuildMode == ListBuildMode::DURING_LOAD ? " into BOTH Array and LinkedList...\n" : " into the Array...\n");
 
     long memoryBefore = getMemoryUsageKB();
     auto totalStartTime = std::chrono::high_resolution_clock::now();
 
-    io::CSVReader<18, io::trim_chars<' '>, io::no_quote_escape<','>> in(filePath);
+    // io::CSVReader reads a snapshot of the file that ends at its last
+    // complete line, so the tail offset is exactly where its rows stopped.
+    MappedCsvFile snapshot;
+    if (!snapshot.open(filePath)) {
+        return false;
+    }
+    const char* loadEnd = lastCompleteLineEnd(snapshot.begin(), snapshot.end());
+    reserveForRows(estimateCsvRowCount(snapshot.begin(), loadEnd));
+
+    io::CSVReader<18, io::trim_chars<' '>, io::double_quote_escape<',', '"'>> in(filePath, snapshot.begin(), loadEnd);
     
     in.read_header(io::ignore_no_column, "transaction_id", "timestamp", "sender_account", "receiver_account", "amount", 
                    "transaction_type", "merchant_category", "location", "device_used", "is_fraud", "fraud_type", 
@@ -55,85 +109,294 @@ bool TransactionManager::loadTransactionsFromCsv(const std::string& filePath) {
                 fraud_s, ft, tsl, sds_s, vs_s, gas_s, pc, ip, dh;
 
     int count = 0;
+    const bool fillList = listBuildMode == ListBuildMode::DURING_LOAD;
     std::chrono::duration<double, std::milli> array_load_time(0);
     std::chrono::duration<double, std::milli> list_load_time(0);
 
-    while (in.read_row(id, ts, sa, ra, amt_s, tt, mc, loc, du, fraud_s, ft, tsl, sds_s, vs_s, gas_s, pc, ip, dh)) {
-        if (count > 50000){
+    // With a reject log a malformed row is recorded and skipped; without
+    // one the load stops at it.
+    if (rejectLog != nullptr) rejectLog->resetCounts();
+    auto rejectRow = [&](ParseErrorKind kind, const std::string& message, const std::string& text) {
+        if (rejectLog == nullptr) {
+            std::cerr << "Error reading " << filePath << ": line " << in.get_file_line() << ": " << message << "\n";
+            return false;
+        }
+        rejectLog->record(filePath, in.get_file_line(), kind, message, text.data(), text.size());
+        return true;
+    };
+
+    while (true) {
+        try {
+            if (!in.read_row(id, ts, sa, ra, amt_s, tt, mc, loc, du, fraud_s, ft, tsl, sds_s, vs_s, gas_s, pc, ip, dh)) {
+                break;
+            }
+        } catch (const io::error::too_few_columns& e) {
+            if (rejectRow(ParseErrorKind::ROW_SHAPE, e.what(), "")) continue;
+            return false;
+        } catch (const io::error::too_many_columns& e) {
+            if (rejectRow(ParseErrorKind::ROW_SHAPE, e.what(), "")) continue;
+            return false;
+        } catch (const io::error::escaped_string_not_closed& e) {
+            if (rejectRow(ParseErrorKind::QUOTING, e.what(), "")) continue;
+            return false;
+        }
+        if (rowLimit > 0 && count >= rowLimit) {
             break;
         }
 
+        // read_row fills the strings in CsvColumn order, so the same
+        // (projecting) conversion as the mapped reader applies.
+        const std::string* row[CSV_COLUMN_COUNT] = {&id, &ts, &sa, &ra, &amt_s, &tt, &mc, &loc, &du,
+                                                     &fraud_s, &ft, &tsl, &sds_s, &vs_s, &gas_s, &pc, &ip, &dh};
+        CsvField fields[CSV_COLUMN_COUNT];
+        for (int c = 0; c < CSV_COLUMN_COUNT; ++c) {
+            fields[c].data = row[c]->data();
+            fields[c].length = row[c]->size();
+        }
         Transaction tx;
-        tx.transaction_id = std::move(id);
-        tx.timestamp = std::move(ts);
-        tx.sender_account = std::move(sa);
-        tx.receiver_account = std::move(ra);
-        tx.amount = std::strtod(amt_s.c_str(), nullptr);
-        tx.transaction_type = std::move(tt);
-        tx.merchant_category = std::move(mc);
-        tx.location = std::move(loc);
-        tx.device_used = std::move(du);
-        tx.is_fraud = (fraud_s == "True" || fraud_s == "true");
-        tx.fraud_type = std::move(ft);
-        tx.time_since_last_transaction = std::move(tsl);
-        tx.spending_deviation_score = std::strtod(sds_s.c_str(), nullptr);
-        tx.velocity_score = std::strtod(vs_s.c_str(), nullptr);
-        tx.geo_anomaly_score = std::strtod(gas_s.c_str(), nullptr);
-        tx.payment_channel = std::move(pc);
-        tx.ip_address = std::move(ip);
-        tx.device_hash = std::move(dh);
+        TransactionText text;
+        try {
+            fillTransactionFromFields(fields, tx, text, columns);
+        } catch (const ParseError& e) {
+            std::string rowText;
+            for (int c = 0; c < CSV_COLUMN_COUNT; ++c) {
+                if (c > 0) rowText += ',';
+                rowText += *row[c];
+            }
+            if (rejectRow(e.getKind(), e.what(), rowText)) continue;
+            return false;
+        }
 
         auto start_array = std::chrono::high_resolution_clock::now();
-        transactionsArray.addTransaction(tx);
+        if (fillList) {
+            transactionsArray.addTransaction(tx, text);
+        } else {
+            transactionsArray.addTransaction(std::move(tx), std::move(text));
+        }
         auto end_array = std::chrono::high_resolution_clock::now();
         array_load_time += (end_array - start_array);
 
-        auto start_list = std::chrono::high_resolution_clock::now();
-        transactionsLinkedList.addTransaction(tx);
-        auto end_list = std::chrono::high_resolution_clock::now();
-        list_load_time += (end_list - start_list);
+        if (fillList) {
+            auto start_list = std::chrono::high_resolution_clock::now();
+            transactionsLinkedList.addTransaction(std::move(tx), std::move(text));
+            auto end_list = std::chrono::high_resolution_clock::now();
+            list_load_time += (end_list - start_list);
+        }
 
         count++;
     }
 
+    releaseUnusedCapacity();
+
+    loadedByteOffset = static_cast<std::size_t>(loadEnd - snapshot.begin());
+
     auto totalEndTime = std::chrono::high_resolution_clock::now();
     auto totalDuration = std::chrono::duration_cast<std::chrono::milliseconds>(totalEndTime - totalStartTime);
     long memoryAfter = getMemoryUsageKB();
     long memoryUsed = memoryAfter - memoryBefore;
 
-    std::cout << "Transactions loaded successfully. Total: " << count << " transactions in each data structure.\n";
+    startLinkedListBuild();
+    std::cout << "Transactions loaded successfully. Total: " << count << " transactions"
+              << (fillList ? " in each data structure.\n" : ".\n");
     
     std::cout << "-----------------------------------------\n";
     std::cout << "Time to populate TransactionArray:      " << array_load_time.count() << " ms\n";
-    std::cout << "Time to populate TransactionLinkedList: " << list_load_time.count() << " ms\n";
+    if (fillList) {
+        std::cout << "Time to populate TransactionLinkedList: " << list_load_time.count() << " ms\n";
+    } else {
+        std::cout << "Time to populate TransactionLinkedList: "
+                  << (listBuildMode == ListBuildMode::BACKGROUND ? "building in the background" : "deferred until first use") << "\n";
+    }
     std::cout << "Total loading time:                     " << totalDuration.count() << " ms\n";
     std::cout << "Memory usage:                           " << memoryUsed << " KB (current total: " << memoryAfter << " KB)\n";
+    printLoadedColumns(columns);
     std::cout << "-----------------------------------------\n";
+    if (rejectLog != nullptr) rejectLog->printSummary("Loading " + filePath);
 
+    loadedColumns = columns;
     return true;
 }
 
-int TransactionManager::getTransactionCount() const {
-    if (useArrayDataStructure) {
-        return transactionsArray.getSize();
-    } else {
-        return transactionsLinkedList.getSize();
+void TransactionManager::reserveForRows(int rows) {
+    if (rowLimit > 0 && rows > rowLimit) {
+        rows = static_cast<int>(rowLimit);
     }
+    transactionsArray.reserve(transactionsArray.getSize() + rows);
 }
 
-Transaction* TransactionManager::getTransactionPtrAt(int index) {
-    if (useArrayDataStructure) {
-        return transactionsArray.getTransaction(index);
+void TransactionManager::releaseUnusedCapacity() {
+    const int size = transactionsArray.getSize();
+    if (transactionsArray.getCapacity() > size + size / 4 + 16) {
+        transactionsArray.shrinkToFit();
+    }
+    // The array keeps the chunks' text blocks, so the chunks' freed records
+    // sit between them on the heap; hand those pages back.
+    malloc_trim(0);
+}
+
+bool TransactionManager::loadTransactionsFromCsvMapped(const std::string& filePath, CsvColumnSet columns) {
+    loadedSourcePath = filePath;
+    arraySorted = listSorted = columnsSorted = unrolledSorted = false;
+    transactionsArrayView = TransactionArrayView();
+    std::cout << "Loading transactions from " << filePath << " (memory-mapped, " << resolveThreadCount(parseThreadCount)
+              << " parser threads)"
+              << (listBuildMode == ListBuildMode::DURING_LOAD ? " into BOTH Array and LinkedList...\n" : " into the Array...\n");
+
+    long memoryBefore = getMemoryUsageKB();
+    auto totalStartTime = std::chrono::high_resolution_clock::now();
+
+    MappedCsvFile file;
+    if (!file.open(filePath)) {
+        return false;
+    }
+
+    const char* cursor = file.begin();
+    CsvColumnLayout layout;
+    if (!layout.parseHeader(cursor, file.end())) {
+        return false;
+    }
+    // A row the writer is still appending is left for appendNewRows().
+    const char* loadEnd = lastCompleteLineEnd(cursor, file.end());
+    reserveForRows(estimateCsvRowCount(cursor, loadEnd));
+
+    int count = 0;
+    const bool fillList = listBuildMode == ListBuildMode::DURING_LOAD;
+    std::chrono::duration<double, std::milli> array_load_time(0);
+    std::chrono::duration<double, std::milli> list_load_time(0);
+
+    // Chunks arrive in file order, so both structures keep the CSV row order.
+    // The list copies the text it needs; the array then adopts the chunk's
+    // text as it is, so the parser's copy is the only one it gets.
+    auto appendChunk = [&](TransactionArray& rows) {
+        int take = rows.getSize();
+        if (rowLimit > 0 && count + take > rowLimit) {
+            take = static_cast<int>(rowLimit - count);
+        }
+
+        if (fillList) {
+            auto start_list = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < take; ++i) {
+                const Transaction& tx = *rows.getTransaction(i);
+                transactionsLinkedList.addTransaction(tx, rows.getText(tx));
+            }
+            auto end_list = std::chrono::high_resolution_clock::now();
+            list_load_time += (end_list - start_list);
+        }
+
+        auto start_array = std::chrono::high_resolution_clock::now();
+        transactionsArray.adoptRows(rows, take);
+        auto end_array = std::chrono::high_resolution_clock::now();
+        array_load_time += (end_array - start_array);
+
+        count += take;
+        return rowLimit <= 0 || count < rowLimit;
+    };
+
+    CsvParseOptions options;
+    options.columns = columns;
+    options.textStorage = textStorage;
+    options.rejects = rejectLog;
+    options.sourceName = filePath;
+    if (rejectLog != nullptr) rejectLog->resetCounts();
+    try {
+        parseCsvChunksInOrder(cursor, loadEnd, layout, parseThreadCount, appendChunk, options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading " << filePath << ": " << e.what() << "\n";
+        return false;
+    }
+    loadedByteOffset = static_cast<std::size_t>(loadEnd - file.begin());
+    releaseUnusedCapacity();
+
+    auto totalEndTime = std::chrono::high_resolution_clock::now();
+    auto totalDuration = std::chrono::duration_cast<std::chrono::milliseconds>(totalEndTime - totalStartTime);
+    long memoryAfter = getMemoryUsageKB();
+    long memoryUsed = memoryAfter - memoryBefore;
+
+    startLinkedListBuild();
+    std::cout << "Transactions loaded successfully. Total: " << count << " transactions"
+              << (fillList ? " in each data structure.\n" : ".\n");
+
+    std::cout << "-----------------------------------------\n";
+    std::cout << "Time to populate TransactionArray:      " << array_load_time.count() << " ms\n";
+    if (fillList) {
+        std::cout << "Time to populate TransactionLinkedList: " << list_load_time.count() << " ms\n";
     } else {
-        return transactionsLinkedList.getTransaction(index);
+        std::cout << "Time to populate TransactionLinkedList: "
+                  << (listBuildMode == ListBuildMode::BACKGROUND ? "building in the background" : "deferred until first use") << "\n";
+    }
+    std::cout << "Total loading time:                     " << totalDuration.count() << " ms\n";
+    std::cout << "Memory usage:                           " << memoryUsed << " KB (current total: " << memoryAfter << " KB)\n";
+    printLoadedColumns(columns);
+    std::cout << "-----------------------------------------\n";
+    if (rejectLog != nullptr) rejectLog->printSummary("Loading " + filePath);
+
+    loadedColumns = columns;
+    return true;
+}
+
+bool TransactionManager::requireColumns(CsvColumnSet needed, const std::string& operation) {
+    // Streaming batches are always parsed in full.
+    CsvColumnSet missing = needed & ~loadedColumns;
+    if (streamingMode || missing == 0) {
+        return true;
+    }
+    if (loadedSourcePath.empty()) {
+        std::cerr << Color::RED << operation << " needs column(s) that are not loaded: "
+                  << csvColumnListToString(missing) << Color::RESET << "\n";
+        return false;
+    }
+
+    std::cout << Color::YELLOW << operation << " needs column(s) that were not loaded: " << csvColumnListToString(missing)
+              << ". Reloading " << loadedSourcePath << " with them..." << Color::RESET << "\n";
+    waitForBackgroundListBuild();
+    const CsvColumnSet wanted = loadedColumns | needed;
+    transactionsArrayView = TransactionArrayView();
+    int rows = transactionsArray.getSize();
+    transactionsArray = TransactionArray(rows > 0 ? rows : 10, textStorage);
+    transactionsLinkedList = TransactionLinkedList(textStorage);
+    transactionsColumns = TransactionStore();
+    transactionsUnrolled = TransactionUnrolledList(textStorage);
+    loadedColumns = 0;
+    if (!loadTransactionsFromCsv(loadedSourcePath, wanted)) {
+        std::cerr << Color::RED << "Could not load the missing column(s); " << operation << " cancelled."
+                  << Color::RESET << "\n";
+        return false;
+    }
+    return true;
+}
+
+void TransactionManager::setTextStorage(TextStorage storage) {
+    textStorage = storage;
+    transactionsArrayView = TransactionArrayView();
+    transactionsArray = TransactionArray(10, storage);
+    transactionsLinkedList = TransactionLinkedList(storage);
+    transactionsUnrolled = TransactionUnrolledList(storage);
+}
+
+int TransactionManager::getTransactionCount() const {
+    switch (activeStructure) {
+        case DataStructureType::ARRAY: return transactionsArray.getSize();
+        case DataStructureType::LINKED_LIST: return transactionsLinkedList.getSize();
+        case DataStructureType::UNROLLED_LIST: return transactionsUnrolled.getSize();
+        default: return transactionsColumns.getSize();
     }
 }
 
 std::string TransactionManager::getCurrentDataStructureName() const {
-    if (useArrayDataStructure) {
-        return "Array-Based (TransactionArray)";
-    } else {
-        return "LinkedList-Based (TransactionLinkedList)";
+    switch (activeStructure) {
+        case DataStructureType::ARRAY: return "Array-Based (TransactionArray)";
+        case DataStructureType::LINKED_LIST: return "LinkedList-Based (TransactionLinkedList)";
+        case DataStructureType::UNROLLED_LIST: return "Unrolled LinkedList (TransactionUnrolledList)";
+        default: return "Columnar (TransactionStore)";
+    }
+}
+
+std::string TransactionManager::getActiveStructureTag() const {
+    switch (activeStructure) {
+        case DataStructureType::ARRAY: return "array";
+        case DataStructureType::LINKED_LIST: return "linkedlist";
+        case DataStructureType::UNROLLED_LIST: return "unrolled";
+        default: return "columnar";
     }
 }
 
@@ -149,9 +412,11 @@ void TransactionManager::switchDataStructure() {
     std::cout << "=========================================\n";
     std::cout << "1. Use Array-Based Structure\n";
     std::cout << "2. Use LinkedList-Based Structure\n";
+    std::cout << "3. Use Columnar Store (one array per field)\n";
+    std::cout << "4. Use Unrolled LinkedList (" << TransactionBlock::ROWS_PER_BLOCK << " rows per node)\n";
     std::cout << "-----------------------------------------\n";
     std::cout << "Current selection: " << getCurrentDataStructureName() << "\n";
-    std::cout << "Enter your choice (1 or 2): ";
+    std::cout << "Enter your choice (1-4): ";
 
     int choice;
     std::cin >> choice;
@@ -164,11 +429,20 @@ void TransactionManager::switchDataStructure() {
     }
 
     if (choice == 1) {
-        useArrayDataStructure = true;
+        activeStructure = DataStructureType::ARRAY;
         std::cout << "\n✅ Switched to Array-Based data structure.\n";
     } else if (choice == 2) {
-        useArrayDataStructure = false;
+        ensureLinkedList();
+        activeStructure = DataStructureType::LINKED_LIST;
         std::cout << "\n✅ Switched to LinkedList-Based data structure.\n";
+    } else if (choice == 3) {
+        ensureColumnStore();
+        activeStructure = DataStructureType::COLUMNAR;
+        std::cout << "\n✅ Switched to Columnar data structure.\n";
+    } else if (choice == 4) {
+        ensureUnrolledList();
+        activeStructure = DataStructureType::UNROLLED_LIST;
+        std::cout << "\n✅ Switched to Unrolled LinkedList data structure.\n";
     } else {
         std::cout << "\n❌ Invalid choice. No changes made.\n";
     }
@@ -5,8 +5,15 @@
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <functional>
+#include <thread>
+#include <chrono>
+#include <cstddef>
 #include "transaction.h"
 #include "custom_data_structures.h"
+#include "transaction_store.h"
+#include "fast_csv_reader.h"
+#include "csv_reject_log.h"
 
 namespace Color {
     extern const std::string RESET;
@@ -30,19 +37,179 @@ namespace Color {
 }
 
 
+// Current RSS (VmRSS) of the process.
+long getMemoryUsageKB();
+// Peak RSS (VmHWM) of the process; resetPeakMemoryUsage() restarts the
+// measurement so a single operation can be checked against a budget.
+long getPeakMemoryUsageKB();
+void resetPeakMemoryUsage();
+
+enum class SortField {
+    LOCATION,
+    AMOUNT,
+    TIMESTAMP
+};
+
+// The structure sort, search and export work on.
+enum class DataStructureType {
+    ARRAY,
+    LINKED_LIST,
+    COLUMNAR,
+    UNROLLED_LIST
+};
+
+// When the TransactionLinkedList copy of the loaded rows is built. The
+// array is always filled by the load itself.
+enum class ListBuildMode {
+    ON_FIRST_USE,   // when the list is first switched to
+    BACKGROUND,     // on a background thread as soon as the load finishes
+    DURING_LOAD     // row by row alongside the array
+};
+
+// What sorting the array leaves behind. Either way the sort itself orders
+// (key, row) pairs rather than records.
+enum class ArraySortMode {
+    VIEW,       // the records stay put; transactionsArrayView reads them in order
+    REORDER     // the records are moved into the sorted order once
+};
+
 class TransactionManager {
 public:
     TransactionArray transactionsArray;
+    // Active after a sort in ArraySortMode::VIEW: the array's rows in sorted
+    // order. Display, search and export read the array through it.
+    TransactionArrayView transactionsArrayView;
     TransactionLinkedList transactionsLinkedList;
+    TransactionStore transactionsColumns;
+    TransactionUnrolledList transactionsUnrolled;
     
-    bool useArrayDataStructure;
+    DataStructureType activeStructure;
+    TextStorage textStorage;
+    int parseThreadCount;
+    bool useLegacyCsvReader;
+    long rowLimit;
+    CsvColumnSet loadedColumns;
+    std::string loadedSourcePath;
+    bool multiFileSource;
+    int fileLoadThreadCount;
+    int sortThreadCount;
+    CsvRejectLog* rejectLog;
+
+    ListBuildMode listBuildMode;
+    ArraySortMode arraySortMode;
+    bool linkedListReady;
+    std::thread listBuilder;
+    double listBuildMs;
+    // The columnar copy is built from the array the first time it is used.
+    bool columnStoreReady;
+    double columnBuildMs;
+    // Likewise the unrolled list.
+    bool unrolledListReady;
+    double unrolledBuildMs;
+
+    // Byte offset just past the last row taken from loadedSourcePath, and
+    // the field each structure was last sorted by (if it still is), so rows
+    // appended to the file later can be merged into place.
+    std::size_t loadedByteOffset;
+    bool arraySorted, listSorted, columnsSorted, unrolledSorted;
+    SortField arraySortField, listSortField, columnsSortField, unrolledSortField;
+    int tailPollSeconds;
+    std::chrono::steady_clock::time_point lastTailPoll;
+
+    bool streamingMode;
+    std::string streamSourcePath;
+    long streamMemoryBudgetMB;
 
 public:
     TransactionManager();
 
-    ~TransactionManager() = default;
+    ~TransactionManager();
+
+    // Only the given columns are parsed and stored; the rest keep the
+    // Transaction defaults until requireColumns() loads them.
+    bool loadTransactionsFromCsv(const std::string& filePath, CsvColumnSet columns = ALL_CSV_COLUMNS);
+    bool loadTransactionsFromCsvMapped(const std::string& filePath, CsvColumnSet columns = ALL_CSV_COLUMNS);
+    // Loads every file a directory or glob names (see expandCsvSources), one
+    // file per thread, and appends them to the structures in name order.
+    // loadTransactionsFromCsv() calls this for such sources.
+    bool loadTransactionsFromFiles(const std::string& source, CsvColumnSet columns = ALL_CSV_COLUMNS);
+    void compareCsvLoaders(const std::string& filePath);
+    // Times filter scans over the hot Transaction records against a copy
+    // with the text columns inline, as they were stored before.
+    void compareRecordLayouts();
+
+    // Parser threads for the mapped loader; 0 uses every core.
+    void setParseThreadCount(int threads) { parseThreadCount = threads; }
+    int getParseThreadCount() const { return parseThreadCount; }
+
+    // Files loaded at once for a multi-file source; 0 uses every core.
+    void setFileLoadThreadCount(int threads) { fileLoadThreadCount = threads; }
+
+    // Threads for merge sorting the array; 0 uses every core.
+    void setSortThreadCount(int threads) { sortThreadCount = threads; }
+    int getSortThreadCount() const { return sortThreadCount; }
 
-    bool loadTransactionsFromCsv(const std::string& filePath);
+    // Loads through io::CSVReader instead of the mapped SIMD reader
+    // (single-threaded; kept as the reference implementation).
+    void setUseLegacyCsvReader(bool useLegacy) { useLegacyCsvReader = useLegacy; }
+
+    // 0 loads every row.
+    void setRowLimit(long limit) { rowLimit = limit; }
+
+    // With a reject log every loader skips malformed rows, records them in
+    // it and reports the counts per error class; without one (the default)
+    // a malformed row fails the load. The log is not owned.
+    void setRejectLog(CsvRejectLog* log) { rejectLog = log; }
+
+    void setListBuildMode(ListBuildMode mode) { listBuildMode = mode; }
+    void setArraySortMode(ArraySortMode mode) { arraySortMode = mode; }
+    ArraySortMode getArraySortMode() const { return arraySortMode; }
+    // How the array and list keep the text columns. Call before loading;
+    // replaces both (empty) containers.
+    void setTextStorage(TextStorage storage);
+    // Called by the loaders once the array holds every row.
+    void startLinkedListBuild();
+    // Called by the loaders before and after adding the rows: make room in
+    // the array for rows more (no more than the row limit allows), then
+    // give back what a short estimate or the limit left unused.
+    void reserveForRows(int rows);
+    void releaseUnusedCapacity();
+    // Builds (or waits for) the linked list, copying the array in its
+    // current order. Called before anything reads the list.
+    void ensureLinkedList();
+    // The array must not change while the background build copies it; call
+    // this before sorting or reloading it.
+    void waitForBackgroundListBuild();
+    // Builds the TransactionStore from the array, in its current order, if
+    // it is not built yet.
+    void ensureColumnStore();
+    // The same for the TransactionUnrolledList.
+    void ensureUnrolledList();
+
+    // Reads the rows appended to the source file since the last load or
+    // tail, up to its last complete line, and adds them to the loaded
+    // structures; sorted structures stay sorted. Returns the number of rows
+    // added, or -1 on error (nothing is added then).
+    int appendNewRows();
+    // With a poll interval set, pollForNewRows() tails the file when at
+    // least that many seconds have passed since the last check.
+    void setTailPollSeconds(int seconds) { tailPollSeconds = seconds; }
+    void pollForNewRows();
+    void markSorted(DataStructureType structure, SortField field);
+
+    CsvColumnSet getLoadedColumns() const { return loadedColumns; }
+    // Makes sure every column in `needed` is loaded before an operation that
+    // reads it, reloading the source file with the extra columns if not.
+    // Returns false (after saying why) if the reload fails.
+    bool requireColumns(CsvColumnSet needed, const std::string& operation);
+
+    // Streaming mode keeps nothing resident: sort, search and export re-read
+    // the CSV in fixed-size batches sized from the memory budget.
+    bool enableStreamingMode(const std::string& filePath, long memoryBudgetMB);
+    bool isStreaming() const { return streamingMode; }
+    long getMemoryBudgetMB() const { return streamMemoryBudgetMB; }
+    int getStreamBatchRows() const;
+    bool forEachStreamBatch(const std::function<bool(TransactionArray& batch)>& process);
 
     void storeByPaymentChannel();
     void sortTransactions();
@@ -50,28 +217,51 @@ public:
     void generateJson(const std::string& outputFilePath);
     void displayAll();
 
+    // Rows of the active structure are read by iterating the container
+    // itself (begin()/end()), which is linear for the lists too.
     int getTransactionCount() const;
-    Transaction* getTransactionPtrAt(int index);
     std::string getCurrentDataStructureName() const;
     void switchDataStructure();
 
     void displayCurrentStructureInfo() const;
 
-    void setActiveDataStructure(bool useArray) { 
-        useArrayDataStructure = useArray; 
+    void setActiveDataStructure(DataStructureType structure) { 
+        if (structure == DataStructureType::LINKED_LIST) ensureLinkedList();
+        if (structure == DataStructureType::COLUMNAR) ensureColumnStore();
+        if (structure == DataStructureType::UNROLLED_LIST) ensureUnrolledList();
+        activeStructure = structure; 
         std::cout << Color::CYAN << "🔄 Active data structure switched to: " 
                   << getCurrentDataStructureName() << Color::RESET << "\n";
     }
     
+    DataStructureType getActiveStructure() const {
+        return activeStructure;
+    }
+
     bool isUsingArray() const { 
-        return useArrayDataStructure; 
+        return activeStructure == DataStructureType::ARRAY; 
     }
+
+    bool isUsingColumns() const {
+        return activeStructure == DataStructureType::COLUMNAR;
+    }
+
+    bool isUsingUnrolledList() const {
+        return activeStructure == DataStructureType::UNROLLED_LIST;
+    }
+
+    // "array", "linkedlist", "columnar" or "unrolled", for result file names.
+    std::string getActiveStructureTag() const;
     
     std::string getActiveDataStructureName() const {
-        if (useArrayDataStructure) {
+        if (activeStructure == DataStructureType::ARRAY) {
             return Color::GREEN + "Array-Based (TransactionArray)" + Color::RESET;
-        } else {
+        } else if (activeStructure == DataStructureType::LINKED_LIST) {
             return Color::BLUE + "LinkedList-Based (TransactionLinkedList)" + Color::RESET;
+        } else if (activeStructure == DataStructureType::UNROLLED_LIST) {
+            return Color::CYAN + "Unrolled LinkedList (TransactionUnrolledList)" + Color::RESET;
+        } else {
+            return Color::MAGENTA + "Columnar (TransactionStore)" + Color::RESET;
         }
     }
     
@@ -85,10 +275,18 @@ public:
         std::cout << Color::YELLOW << "Total Transactions: " << Color::RESET 
                   << getTransactionCount() << "\n";
         
-        if (useArrayDataStructure) {
+        if (activeStructure == DataStructureType::ARRAY) {
             std::cout << "\n" << Color::GREEN << "📈 Array Benefits:" << Color::RESET << "\n";
             std::cout << "  • O(1) random access time\n";
             std::cout << "  • Cache-friendly memory access pattern\n";
+        } else if (activeStructure == DataStructureType::COLUMNAR) {
+            std::cout << "\n" << Color::GREEN << "📈 Columnar Store Benefits:" << Color::RESET << "\n";
+            std::cout << "  • A scan reads only the columns it filters on\n";
+            std::cout << "  • is_fraud is one bit per row\n";
+        } else if (activeStructure == DataStructureType::UNROLLED_LIST) {
+            std::cout << "\n" << Color::GREEN << "📈 Unrolled LinkedList Benefits:" << Color::RESET << "\n";
+            std::cout << "  • One pointer per " << TransactionBlock::ROWS_PER_BLOCK << " rows to follow\n";
+            std::cout << "  • Inserts and removals shift at most one block\n";
         } else {
             std::cout << "\n" << Color::GREEN << "📈 LinkedList Benefits:" << Color::RESET << "\n";
             std::cout << "  • Dynamic memory allocation\n";
@@ -98,6 +296,9 @@ public:
     }
 
     void performFullStructureSortComparison(); 
+    // Times merge sorts of the array and the list by each field through a
+    // std::function comparator and through the field's TransactionLess.
+    void compareSortComparators();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "transaction_store.h"
+#include <cstring>
+
+namespace {
+
+// Copies the first `count` entries of column into a new array of newCapacity
+// and replaces it.
+template <typename T>
+void resizeColumn(T*& column, int count, int newCapacity) {
+    T* resized = new T[newCapacity];
+    if (column != nullptr) {
+        std::memcpy(resized, column, sizeof(T) * count);
+        delete[] column;
+    }
+    column = resized;
+}
+
+template <typename T>
+void permuteColumn(T*& column, const int* order, int count, int capacity) {
+    T* permuted = new T[capacity];
+    for (int i = 0; i < count; ++i) {
+        permuted[i] = column[order[i]];
+    }
+    delete[] column;
+    column = permuted;
+}
+
+int fraudWordCount(int capacity) {
+    return capacity / 64 + 1;
+}
+
+}
+
+TransactionStore::TransactionStore(int initialCapacity)
+    : size(0), capacity(0),
+      timestamps(nullptr), amounts(nullptr), spendingDeviationScores(nullptr), velocityScores(nullptr),
+      geoAnomalyScores(nullptr), timesSinceLastTransaction(nullptr), ipAddresses(nullptr),
+      merchantCategories(nullptr), locations(nullptr), transactionTypes(nullptr), devicesUsed(nullptr),
+      paymentChannels(nullptr), fraudTypes(nullptr), fraudBits(nullptr),
+      textRows(nullptr), textOffsets(nullptr), textBytes(nullptr), textSize(0), textCapacity(0) {
+    if (initialCapacity <= 0) {
+        initialCapacity = 10;
+    }
+    allocateColumns(initialCapacity);
+}
+
+TransactionStore::~TransactionStore() {
+    releaseColumns();
+}
+
+void TransactionStore::releaseColumns() {
+    delete[] timestamps;
+    delete[] amounts;
+    delete[] spendingDeviationScores;
+    delete[] velocityScores;
+    delete[] geoAnomalyScores;
+    delete[] timesSinceLastTransaction;
+    delete[] ipAddresses;
+    delete[] merchantCategories;
+    delete[] locations;
+    delete[] transactionTypes;
+    delete[] devicesUsed;
+    delete[] paymentChannels;
+    delete[] fraudTypes;
+    delete[] fraudBits;
+    delete[] textRows;
+    delete[] textOffsets;
+    delete[] textBytes;
+}
+
+void TransactionStore::allocateColumns(int newCapacity) {
+    resizeColumn(timestamps, size, newCapacity);
+    resizeColumn(amounts, size, newCapacity);
+    resizeColumn(spendingDeviationScores, size, newCapacity);
+    resizeColumn(velocityScores, size, newCapacity);
+    resizeColumn(geoAnomalyScores, size, newCapacity);
+    resizeColumn(timesSinceLastTransaction, size, newCapacity);
+    resizeColumn(ipAddresses, size, newCapacity);
+    resizeColumn(merchantCategories, size, newCapacity);
+    resizeColumn(locations, size, newCapacity);
+    resizeColumn(transactionTypes, size, newCapacity);
+    resizeColumn(devicesUsed, size, newCapacity);
+    resizeColumn(paymentChannels, size, newCapacity);
+    resizeColumn(fraudTypes, size, newCapacity);
+    resizeColumn(textRows, size, newCapacity);
+    resizeColumn(textOffsets, size * TEXT_COLUMN_COUNT + 1, newCapacity * TEXT_COLUMN_COUNT + 1);
+
+    uint64_t* bits = new uint64_t[fraudWordCount(newCapacity)]();
+    if (fraudBits != nullptr) {
+        std::memcpy(bits, fraudBits, sizeof(uint64_t) * fraudWordCount(capacity));
+        delete[] fraudBits;
+    }
+    fraudBits = bits;
+    capacity = newCapacity;
+    if (size == 0) {
+        textOffsets[0] = 0;
+    }
+}
+
+void TransactionStore::expandCapacity() {
+    allocateColumns(capacity > 0 ? capacity * 2 : 10);
+}
+
+void TransactionStore::appendText(std::string_view value) {
+    if (textSize + value.size() > textCapacity) {
+        std::size_t newCapacity = textCapacity > 0 ? textCapacity * 2 : 4096;
+        while (newCapacity < textSize + value.size()) newCapacity *= 2;
+        char* grown = new char[newCapacity];
+        if (textBytes != nullptr) {
+            std::memcpy(grown, textBytes, textSize);
+            delete[] textBytes;
+        }
+        textBytes = grown;
+        textCapacity = newCapacity;
+    }
+    std::memcpy(textBytes + textSize, value.data(), value.size());
+    textSize += value.size();
+}
+
+void TransactionStore::addTransaction(const Transaction& tx, const TransactionTextView& text) {
+    if (size == capacity) {
+        expandCapacity();
+    }
+    timestamps[size] = tx.timestamp;
+    amounts[size] = tx.amount;
+    spendingDeviationScores[size] = tx.spending_deviation_score;
+    velocityScores[size] = tx.velocity_score;
+    geoAnomalyScores[size] = tx.geo_anomaly_score;
+    timesSinceLastTransaction[size] = tx.time_since_last_transaction;
+    ipAddresses[size] = tx.ip_address;
+    merchantCategories[size] = tx.merchant_category;
+    locations[size] = tx.location;
+    transactionTypes[size] = tx.transaction_type;
+    devicesUsed[size] = tx.device_used;
+    paymentChannels[size] = tx.payment_channel;
+    fraudTypes[size] = tx.fraud_type;
+    if (tx.is_fraud) {
+        fraudBits[size >> 6] |= uint64_t(1) << (size & 63);
+    }
+
+    // Rows are only ever appended, so the next text row is the row count.
+    textRows[size] = static_cast<uint32_t>(size);
+    std::size_t* offsets = textOffsets + static_cast<std::size_t>(size) * TEXT_COLUMN_COUNT;
+    appendText(text.transaction_id);
+    offsets[1] = textSize;
+    appendText(text.sender_account);
+    offsets[2] = textSize;
+    appendText(text.receiver_account);
+    offsets[3] = textSize;
+    appendText(text.device_hash);
+    offsets[4] = textSize;
+    size++;
+}
+
+Transaction TransactionStore::getTransaction(int row) const {
+    Transaction tx;
+    tx.timestamp = timestamps[row];
+    tx.amount = amounts[row];
+    tx.spending_deviation_score = spendingDeviationScores[row];
+    tx.velocity_score = velocityScores[row];
+    tx.geo_anomaly_score = geoAnomalyScores[row];
+    tx.time_since_last_transaction = timesSinceLastTransaction[row];
+    tx.ip_address = ipAddresses[row];
+    tx.textRow = textRows[row];
+    tx.merchant_category = merchantCategories[row];
+    tx.location = locations[row];
+    tx.transaction_type = transactionTypes[row];
+    tx.device_used = devicesUsed[row];
+    tx.payment_channel = paymentChannels[row];
+    tx.fraud_type = fraudTypes[row];
+    tx.is_fraud = isFraud(row);
+    return tx;
+}
+
+std::string_view TransactionStore::getTextField(int row, TextColumn column) const {
+    std::size_t k = static_cast<std::size_t>(textRows[row]) * TEXT_COLUMN_COUNT + column;
+    return std::string_view(textBytes + textOffsets[k], textOffsets[k + 1] - textOffsets[k]);
+}
+
+TransactionTextView TransactionStore::getText(int row) const {
+    TransactionTextView text;
+    text.transaction_id = getTextField(row, TEXT_TRANSACTION_ID);
+    text.sender_account = getTextField(row, TEXT_SENDER_ACCOUNT);
+    text.receiver_account = getTextField(row, TEXT_RECEIVER_ACCOUNT);
+    text.device_hash = getTextField(row, TEXT_DEVICE_HASH);
+    return text;
+}
+
+void TransactionStore::reorder(const int* order) {
+    permuteColumn(timestamps, order, size, capacity);
+    permuteColumn(amounts, order, size, capacity);
+    permuteColumn(spendingDeviationScores, order, size, capacity);
+    permuteColumn(velocityScores, order, size, capacity);
+    permuteColumn(geoAnomalyScores, order, size, capacity);
+    permuteColumn(timesSinceLastTransaction, order, size, capacity);
+    permuteColumn(ipAddresses, order, size, capacity);
+    permuteColumn(merchantCategories, order, size, capacity);
+    permuteColumn(locations, order, size, capacity);
+    permuteColumn(transactionTypes, order, size, capacity);
+    permuteColumn(devicesUsed, order, size, capacity);
+    permuteColumn(paymentChannels, order, size, capacity);
+    permuteColumn(fraudTypes, order, size, capacity);
+    permuteColumn(textRows, order, size, capacity);
+
+    uint64_t* bits = new uint64_t[fraudWordCount(capacity)]();
+    for (int i = 0; i < size; ++i) {
+        if (isFraud(order[i])) {
+            bits[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+    }
+    delete[] fraudBits;
+    fraudBits = bits;
+}
+
+std::size_t TransactionStore::getMemoryBytes() const {
+    // timestamp, five doubles, ip_address, two 16-bit and four 8-bit codes,
+    // and the text row.
+    const std::size_t perRow = sizeof(int64_t) + 5 * sizeof(double) + sizeof(uint32_t)
+                             + 2 * sizeof(uint16_t) + 4 * sizeof(uint8_t) + sizeof(uint32_t);
+    return perRow * capacity + sizeof(uint64_t) * fraudWordCount(capacity)
+         + sizeof(std::size_t) * (static_cast<std::size_t>(capacity) * TEXT_COLUMN_COUNT + 1) + textCapacity;
+}
+
+void TransactionStore::takeColumns(TransactionStore& other) {
+    size = other.size;
+    capacity = other.capacity;
+    timestamps = other.timestamps;
+    amounts = other.amounts;
+    spendingDeviationScores = other.spendingDeviationScores;
+    velocityScores = other.velocityScores;
+    geoAnomalyScores = other.geoAnomalyScores;
+    timesSinceLastTransaction = other.timesSinceLastTransaction;
+    ipAddresses = other.ipAddresses;
+    merchantCategories = other.merchantCategories;
+    locations = other.locations;
+    transactionTypes = other.transactionTypes;
+    devicesUsed = other.devicesUsed;
+    paymentChannels = other.paymentChannels;
+    fraudTypes = other.fraudTypes;
+    fraudBits = other.fraudBits;
+    textRows = other.textRows;
+    textOffsets = other.textOffsets;
+    textBytes = other.textBytes;
+    textSize = other.textSize;
+    textCapacity = other.textCapacity;
+
+    other.size = 0;
+    other.capacity = 0;
+    other.timestamps = nullptr;
+    other.amounts = nullptr;
+    other.spendingDeviationScores = nullptr;
+    other.velocityScores = nullptr;
+    other.geoAnomalyScores = nullptr;
+    other.timesSinceLastTransaction = nullptr;
+    other.ipAddresses = nullptr;
+    other.merchantCategories = nullptr;
+    other.locations = nullptr;
+    other.transactionTypes = nullptr;
+    other.devicesUsed = nullptr;
+    other.paymentChannels = nullptr;
+    other.fraudTypes = nullptr;
+    other.fraudBits = nullptr;
+    other.textRows = nullptr;
+    other.textOffsets = nullptr;
+    other.textBytes = nullptr;
+    other.textSize = 0;
+    other.textCapacity = 0;
+}
+
+TransactionStore::TransactionStore(TransactionStore&& other) noexcept {
+    takeColumns(other);
+}
+
+TransactionStore& TransactionStore::operator=(TransactionStore&& other) noexcept {
+    if (this != &other) {
+        releaseColumns();
+        takeColumns(other);
+    }
+    return *this;
+}
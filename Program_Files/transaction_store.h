@@ -0,0 +1,98 @@
+#ifndef TRANSACTION_STORE_H
+#define TRANSACTION_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "transaction.h"
+
+// Column-oriented storage of the same rows as TransactionArray: one
+// contiguous array per Transaction field, is_fraud packed one bit per row,
+// and the four text columns of every row back to back in a single byte
+// arena. A scan that filters on one or two columns reads only those.
+//
+// Rows are added as a Transaction plus its text and read back the same way
+// with getTransaction()/getText(), or a column at a time through the get*()
+// pointers, which stay valid until the next addTransaction() or reorder().
+class TransactionStore {
+public:
+    enum TextColumn {
+        TEXT_TRANSACTION_ID,
+        TEXT_SENDER_ACCOUNT,
+        TEXT_RECEIVER_ACCOUNT,
+        TEXT_DEVICE_HASH,
+        TEXT_COLUMN_COUNT
+    };
+
+private:
+    int size;
+    int capacity;
+
+    int64_t* timestamps;
+    double* amounts;
+    double* spendingDeviationScores;
+    double* velocityScores;
+    double* geoAnomalyScores;
+    double* timesSinceLastTransaction;
+    uint32_t* ipAddresses;
+    uint16_t* merchantCategories;
+    uint16_t* locations;
+    uint8_t* transactionTypes;
+    uint8_t* devicesUsed;
+    uint8_t* paymentChannels;
+    uint8_t* fraudTypes;
+    uint64_t* fraudBits;
+
+    // Text is appended once and never moves: row r's column c is
+    // textBytes[textOffsets[k], textOffsets[k + 1]) with
+    // k = textRows[r] * TEXT_COLUMN_COUNT + c, so reorder() only permutes
+    // textRows.
+    uint32_t* textRows;
+    std::size_t* textOffsets;
+    char* textBytes;
+    std::size_t textSize;
+    std::size_t textCapacity;
+
+    void allocateColumns(int newCapacity);
+    void releaseColumns();
+    void expandCapacity();
+    void appendText(std::string_view value);
+    // Moves other's arrays here and leaves it empty, with no storage.
+    void takeColumns(TransactionStore& other);
+
+public:
+    explicit TransactionStore(int initialCapacity = 10);
+    ~TransactionStore();
+    TransactionStore(const TransactionStore&) = delete;
+    TransactionStore& operator=(const TransactionStore&) = delete;
+    TransactionStore(TransactionStore&& other) noexcept;
+    TransactionStore& operator=(TransactionStore&& other) noexcept;
+
+    void addTransaction(const Transaction& tx, const TransactionTextView& text);
+    int getSize() const { return size; }
+
+    // The row gathered back into record form. textRow is the row's index
+    // into this store's text, as for the other containers.
+    Transaction getTransaction(int row) const;
+    // Views into the text arena, valid until the next addTransaction().
+    TransactionTextView getText(int row) const;
+    std::string_view getTextField(int row, TextColumn column) const;
+
+    const int64_t* getTimestamps() const { return timestamps; }
+    const double* getAmounts() const { return amounts; }
+    const double* getVelocityScores() const { return velocityScores; }
+    const uint16_t* getLocations() const { return locations; }
+    const uint8_t* getTransactionTypes() const { return transactionTypes; }
+    const uint8_t* getPaymentChannels() const { return paymentChannels; }
+    // Bit (row % 64) of word (row / 64); bits past getSize() are zero.
+    const uint64_t* getFraudBits() const { return fraudBits; }
+    bool isFraud(int row) const { return (fraudBits[row >> 6] >> (row & 63)) & 1; }
+
+    // Rearranges every column so that row i becomes the old row order[i].
+    // order must be a permutation of [0, getSize()).
+    void reorder(const int* order);
+
+    // Bytes allocated for the columns and the text arena.
+    std::size_t getMemoryBytes() const;
+};
+
+#endif